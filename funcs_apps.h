@@ -0,0 +1,1634 @@
+/******************************************************************************
+ * funcs_apps.h
+ *
+ * Application Kernels in C++ code, common to all architectures: they measure
+ * the memory access patterns of typical data structures and algorithms. Each
+ * kernel has a prepare function which builds its data structure in the thread
+ * area and sets the name and number of operations reported besides the
+ * bandwidth.
+ *
+ ******************************************************************************
+ * Copyright (C) 2013 Timo Bingmann <tb@panthema.net>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Search Trees: random lookups in the sorted keys 1,3,5,... filling the area
+// with different layouts. Lookup keys are drawn from [0,2n), such that half
+// of them hit a key.
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// sorted array of 64-bit keys
+void prepareSearchBinary64Loop(int thread_num, char* memarea, size_t size)
+{
+    uint64_t* array = (uint64_t*)memarea;
+    size_t n = size / sizeof(uint64_t);
+
+    for (size_t i = 0; i < n; ++i)
+        array[i] = 2 * i + 1;
+
+    result_ops(thread_num, "lookups", n);
+}
+
+// classic binary search for the lower bound of random keys (C version)
+void SearchBinary64Loop(char* memarea, size_t size, size_t repeats)
+{
+    const uint64_t* array = (const uint64_t*)memarea;
+    size_t n = size / sizeof(uint64_t);
+    uint64_t sum = 0;
+
+    LCGRandom rnd(gopt_seed);
+
+    do {
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint64_t key = random_below(rnd, 2 * n);
+
+            size_t lo = 0, hi = n;
+
+            while (lo < hi) {
+                size_t mid = (lo + hi) / 2;
+                if (array[mid] < key) lo = mid + 1;
+                else hi = mid;
+            }
+
+            sum += lo;
+        }
+    }
+    while (--repeats != 0);
+
+    keep_value(sum);
+}
+
+REGISTER_PREPARE(SearchBinary64Loop, prepareSearchBinary64Loop, NULL, 8, 8, 1);
+
+// -----------------------------------------------------------------------------
+
+// round the area inward to whole 64 byte cache lines, as thread areas are only
+// aligned to the access size, and return the first line
+static inline uint64_t* search_lines(char* memarea, size_t& size)
+{
+    char* begin = (char*)(((uintptr_t)memarea + 63) & ~(uintptr_t)63);
+    size = (size - std::min<size_t>(size, begin - memarea)) & ~(size_t)63;
+    return (uint64_t*)begin;
+}
+
+// fill the keys of the subtree k of the Eytzinger array in order
+static size_t eytzinger_fill(uint64_t* array, size_t n, size_t k, size_t i)
+{
+    if (k < n)
+    {
+        i = eytzinger_fill(array, n, 2 * k, i);
+        array[k] = 2 * i + 1, ++i;
+        i = eytzinger_fill(array, n, 2 * k + 1, i);
+    }
+    return i;
+}
+
+// Eytzinger array of 64-bit keys: the implicit binary search tree in breadth
+// first order, with the root at index 1 and the children of k at 2k and 2k+1.
+// The array starts on a cache line, such that the eight descendants of k three
+// levels down fill the line at 8k.
+void prepareSearchEytzinger64PrefetchLoop(int thread_num, char* memarea, size_t size)
+{
+    uint64_t* array = search_lines(memarea, size);
+    size_t n = size / sizeof(uint64_t);
+
+    array[0] = 0;
+    eytzinger_fill(array, n, 1, 0);
+
+    result_ops(thread_num, "lookups", n);
+}
+
+// search for the lower bound of random keys in Eytzinger order, prefetching
+// the cache line of the descendants three levels down (C version)
+void SearchEytzinger64PrefetchLoop(char* memarea, size_t size, size_t repeats)
+{
+    const uint64_t* array = search_lines(memarea, size);
+    size_t n = size / sizeof(uint64_t);
+    uint64_t sum = 0;
+
+    LCGRandom rnd(gopt_seed);
+
+    do {
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint64_t key = random_below(rnd, 2 * n);
+
+            size_t k = 1;
+            while (k < n) {
+                __builtin_prefetch(array + 8 * k);
+                k = 2 * k + (array[k] < key);
+            }
+
+            // cancel the right turns after the last left turn
+            k >>= __builtin_ctzll(~(unsigned long long)k) + 1;
+
+            sum += k;
+        }
+    }
+    while (--repeats != 0);
+
+    keep_value(sum);
+}
+
+// thread areas of at least two lines hold one aligned line
+REGISTER_PREPARE(SearchEytzinger64PrefetchLoop, prepareSearchEytzinger64PrefetchLoop, NULL, 8, 8, 16);
+
+// -----------------------------------------------------------------------------
+
+// Layout of a static B+-tree with 64 byte nodes of eight 64-bit keys: inner
+// nodes hold the maximum key of each of their eight children. Levels are
+// stored from the root down to the leaves, which hold all keys in order.
+struct BTreeLayout
+{
+    size_t      levels;
+    size_t      count[24];      // number of nodes on each level
+    size_t      offset[24];     // first node of each level
+
+    // calculate the levels of a tree with the given number of leaves
+    size_t calc(size_t leaves)
+    {
+        size_t nodes = leaves;
+        levels = 1;
+        count[0] = leaves;
+        while (count[levels-1] > 1) {
+            count[levels] = (count[levels-1] + 7) / 8;
+            nodes += count[levels++];
+        }
+        // reverse levels, such that the root is first
+        std::reverse(count, count + levels);
+        offset[0] = 0;
+        for (size_t l = 1; l < levels; ++l)
+            offset[l] = offset[l-1] + count[l-1];
+        return nodes;
+    }
+
+    // calculate the largest tree fitting into size bytes, at least one node
+    BTreeLayout(size_t size)
+    {
+        assert(size >= 64);
+        size_t nodes = size / 64, lo = 1, hi = nodes;
+        while (lo < hi) {
+            size_t mid = (lo + hi + 1) / 2;
+            if (calc(mid) <= nodes) lo = mid; else hi = mid - 1;
+        }
+        calc(lo);
+    }
+
+    size_t keys() const { return count[levels-1] * 8; }
+};
+
+void prepareSearchBTree64Loop(int thread_num, char* memarea, size_t size)
+{
+    uint64_t* tree = search_lines(memarea, size);
+    BTreeLayout t(size);
+
+    // leaves hold the keys in order
+    uint64_t* leaves = tree + t.offset[t.levels-1] * 8;
+    for (size_t i = 0; i < t.keys(); ++i)
+        leaves[i] = 2 * i + 1;
+
+    // inner levels bottom up, with maximum key of missing children
+    for (size_t l = t.levels - 1; l-- > 0; )
+    {
+        uint64_t* node = tree + t.offset[l] * 8;
+        const uint64_t* child = tree + t.offset[l+1] * 8;
+
+        for (size_t c = 0; c < t.count[l] * 8; ++c)
+            node[c] = (c < t.count[l+1]) ? child[c * 8 + 7] : ~(uint64_t)0;
+    }
+
+    result_ops(thread_num, "lookups", size / sizeof(uint64_t));
+}
+
+// search for the lower bound of random keys in a static B+-tree, counting the
+// keys less than the lookup key in each node (C version)
+void SearchBTree64Loop(char* memarea, size_t size, size_t repeats)
+{
+    const uint64_t* tree = search_lines(memarea, size);
+    BTreeLayout t(size);
+    size_t n = size / sizeof(uint64_t);
+    uint64_t range = 2 * t.keys();
+    uint64_t sum = 0;
+
+    LCGRandom rnd(gopt_seed);
+
+    do {
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint64_t key = random_below(rnd, range);
+
+            size_t k = 0;
+            for (size_t l = 0; l < t.levels; ++l)
+            {
+                const uint64_t* node = tree + (t.offset[l] + k) * 8;
+
+                size_t c = 0;
+                for (size_t j = 0; j < 8; ++j)
+                    c += (node[j] < key);
+
+                k = k * 8 + c;
+            }
+
+            sum += k;
+        }
+    }
+    while (--repeats != 0);
+
+    keep_value(sum);
+}
+
+// thread areas of at least two lines hold one aligned node
+REGISTER_PREPARE(SearchBTree64Loop, prepareSearchBTree64Loop, NULL, 8, 8, 16);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Hash Tables: probes of random keys into a table of 64 byte buckets, each
+// holding four 64-bit key/value pairs, filled up to the load factor set by -L
+// with linear probing of buckets. Stored keys are odd, missing keys even, and
+// the key zero marks an empty slot.
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// return the bucket of a key in a table with the given number of buckets
+static inline uint64_t hash_bucket(uint64_t key, uint64_t buckets)
+{
+    uint64_t h = key * 0x9E3779B97F4A7C15LLU;
+    h ^= h >> 29;
+#if __SIZEOF_INT128__
+    return (uint64_t)(((unsigned __int128)h * buckets) >> 64);
+#else
+    return h % buckets;
+#endif
+}
+
+void prepareHashProbe64Loop(int thread_num, char* memarea, size_t size)
+{
+    uint64_t* table = (uint64_t*)memarea;
+    uint64_t buckets = size / 64;
+    uint64_t keys = (uint64_t)(buckets * 4 * gopt_hash_load);
+
+    memset(table, 0, buckets * 64);
+
+    for (uint64_t i = 0; i < keys; ++i)
+    {
+        uint64_t key = 2 * i + 1;
+        uint64_t b = hash_bucket(key, buckets);
+
+        // find the first empty slot from the key's bucket onward
+        uint64_t* slot = table + b * 8;
+        while (*slot != 0) {
+            slot += 2;
+            if (slot == table + buckets * 8) slot = table;
+        }
+
+        slot[0] = key, slot[1] = i;
+    }
+
+    result_param(thread_num, "load", gopt_hash_load);
+    result_ops(thread_num, "probes", size / 16);
+}
+
+// probe random keys of which Hit percent are in the table, summing the values
+// of hits (C version)
+template <int Hit>
+void HashProbe64Loop(char* memarea, size_t size, size_t repeats)
+{
+    const uint64_t* table = (const uint64_t*)memarea;
+    uint64_t buckets = size / 64;
+    uint64_t keys = (uint64_t)(buckets * 4 * gopt_hash_load);
+    size_t n = size / 16;
+    uint64_t sum = 0;
+
+    LCGRandom rnd(gopt_seed);
+
+    do {
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint64_t key = 2 * random_below(rnd, keys) + 1;
+            if (random_below(rnd, 100) >= Hit) key += 1;
+
+            uint64_t b = hash_bucket(key, buckets);
+
+            while (1)
+            {
+                const uint64_t* bucket = table + b * 8;
+
+                if (bucket[0] == key) { sum += bucket[1]; break; }
+                if (bucket[2] == key) { sum += bucket[3]; break; }
+                if (bucket[4] == key) { sum += bucket[5]; break; }
+                if (bucket[6] == key) { sum += bucket[7]; break; }
+
+                // a bucket which is not full ends the probe sequence
+                if (bucket[6] == 0) break;
+
+                if (++b == buckets) b = 0;
+            }
+        }
+    }
+    while (--repeats != 0);
+
+    keep_value(sum);
+}
+
+REGISTER_PREPARE_NAMED(HashProbe64Hit90Loop, HashProbe64Loop<90>, prepareHashProbe64Loop, NULL, 16, 16, 4);
+REGISTER_PREPARE_NAMED(HashProbe64Hit10Loop, HashProbe64Loop<10>, prepareHashProbe64Loop, NULL, 16, 16, 4);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Radix Partitioning: scatter the random 64-bit keys in the first half of the
+// area into 2^LogF partitions in the second half, by their top LogF bits. The
+// partition starts are calculated in advance, as by the histogram pass of a
+// radix sort.
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// store a 64 byte line with non-temporal stores where the architecture has
+// them, the line must be 64 byte aligned.
+static inline void stream_line64(uint64_t* dst, const uint64_t* src)
+{
+#if __x86_64__
+    asm volatile(
+        "movdqa 0*16(%[src]), %%xmm0 \n"
+        "movdqa 1*16(%[src]), %%xmm1 \n"
+        "movdqa 2*16(%[src]), %%xmm2 \n"
+        "movdqa 3*16(%[src]), %%xmm3 \n"
+        "movntdq %%xmm0, 0*16(%[dst]) \n"
+        "movntdq %%xmm1, 1*16(%[dst]) \n"
+        "movntdq %%xmm2, 2*16(%[dst]) \n"
+        "movntdq %%xmm3, 3*16(%[dst]) \n"
+        :
+        : [dst] "r" (dst), [src] "r" (src)
+        : "xmm0", "xmm1", "xmm2", "xmm3", "memory");
+#elif __aarch64__
+    asm volatile(
+        "ldp    q0, q1, [%[src]] \n"
+        "ldp    q2, q3, [%[src], #32] \n"
+        "stnp   q0, q1, [%[dst]] \n"
+        "stnp   q2, q3, [%[dst], #32] \n"
+        :
+        : [dst] "r" (dst), [src] "r" (src)
+        : "v0", "v1", "v2", "v3", "memory");
+#else
+    memcpy(dst, src, 64);
+#endif
+}
+
+// order non-temporal stores before following stores
+static inline void stream_fence()
+{
+#if __x86_64__
+    asm volatile("sfence" : : : "memory");
+#elif __aarch64__
+    asm volatile("dmb    ishst" : : : "memory");
+#endif
+}
+
+// Auxiliary memory of the radix partitioning kernels: partition starts,
+// write cursors, and one 64 byte aligned line buffer per partition.
+struct RadixScatterAux
+{
+    uint64_t*   start;
+    uint64_t*   cursor;
+    uint64_t*   buffer;
+
+    RadixScatterAux(char* aux, size_t fanout)
+    {
+        start = (uint64_t*)aux;
+        cursor = start + fanout;
+        buffer = (uint64_t*)(((uintptr_t)(cursor + fanout) + 63) & ~(uintptr_t)63);
+    }
+
+    static size_t size(size_t fanout) { return fanout * (2 * 8 + 64) + 64; }
+};
+
+// return the output in the second half of the area, starting on a cache line
+// as thread areas are only aligned to the access size, such that lines of the
+// output are whole lines in memory, and the number n of keys fitting into it
+static inline uint64_t* radix_output(char* memarea, size_t size, size_t& n)
+{
+    char* begin = (char*)(((uintptr_t)(memarea + size / 2) + 63) & ~(uintptr_t)63);
+    n = std::min<size_t>(size / 16, (memarea + size - begin) / sizeof(uint64_t));
+    return (uint64_t*)begin;
+}
+
+template <int LogF>
+void prepareRadixScatter64Loop(int thread_num, char* memarea, size_t size)
+{
+    static const size_t fanout = (size_t)1 << LogF;
+
+    uint64_t* input = (uint64_t*)memarea;
+    size_t n;
+    radix_output(memarea, size, n);
+
+    RadixScatterAux aux(thread_auxarea(RadixScatterAux::size(fanout)), fanout);
+
+    LCGRandom rnd(gopt_seed);
+
+    for (size_t p = 0; p < fanout; ++p)
+        aux.start[p] = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        input[i] = rnd();
+        ++aux.start[input[i] >> (64 - LogF)];
+    }
+
+    // exclusive prefix sum of the histogram
+    for (size_t p = 0, sum = 0; p < fanout; ++p) {
+        size_t count = aux.start[p];
+        aux.start[p] = sum;
+        sum += count;
+    }
+
+    result_ops(thread_num, "keys", n);
+    // aligning the output may leave room for fewer keys than half the area
+    result_touched(thread_num, n * 16);
+}
+
+// scatter each key directly to its partition (C version)
+template <int LogF>
+void RadixScatter64Loop(char* memarea, size_t size, size_t repeats)
+{
+    static const size_t fanout = (size_t)1 << LogF;
+
+    const uint64_t* input = (const uint64_t*)memarea;
+    size_t n;
+    uint64_t* output = radix_output(memarea, size, n);
+
+    RadixScatterAux aux(t_auxarea, fanout);
+
+    do {
+        memcpy(aux.cursor, aux.start, fanout * sizeof(uint64_t));
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint64_t key = input[i];
+            output[ aux.cursor[key >> (64 - LogF)]++ ] = key;
+        }
+    }
+    while (--repeats != 0);
+}
+
+// scatter each key into a cache line buffer of its partition, and flush full
+// buffers with non-temporal stores: software write-combining (C version)
+template <int LogF>
+void RadixScatterWC64Loop(char* memarea, size_t size, size_t repeats)
+{
+    static const size_t fanout = (size_t)1 << LogF;
+
+    const uint64_t* input = (const uint64_t*)memarea;
+    size_t n;
+    uint64_t* output = radix_output(memarea, size, n);
+
+    RadixScatterAux aux(t_auxarea, fanout);
+
+    do {
+        memcpy(aux.cursor, aux.start, fanout * sizeof(uint64_t));
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint64_t key = input[i];
+            size_t p = key >> (64 - LogF);
+            uint64_t pos = aux.cursor[p]++;
+
+            // the buffer mirrors the alignment of the output line
+            uint64_t* line = aux.buffer + p * 8;
+            line[pos % 8] = key;
+
+            if (pos % 8 == 7)
+            {
+                uint64_t base = pos - 7;
+                if (base >= aux.start[p])
+                    stream_line64(output + base, line);
+                else // first line is partially of the previous partition
+                    for (uint64_t j = aux.start[p]; j <= pos; ++j)
+                        output[j] = line[j % 8];
+            }
+        }
+
+        // write the remaining partially filled lines
+        for (size_t p = 0; p < fanout; ++p)
+        {
+            uint64_t end = aux.cursor[p];
+            uint64_t j = std::max(end & ~(uint64_t)7, aux.start[p]);
+            for ( ; j < end; ++j)
+                output[j] = aux.buffer[p * 8 + j % 8];
+        }
+
+        stream_fence();
+    }
+    while (--repeats != 0);
+}
+
+#define REGISTER_RADIX_SCATTER(F, LogF)                                \
+    REGISTER_PREPARE_NAMED(RadixScatter64Fanout##F##Loop, RadixScatter64Loop<LogF>, \
+                           prepareRadixScatter64Loop<LogF>, NULL, 16, 16, 8); \
+    REGISTER_PREPARE_NAMED(RadixScatterWC64Fanout##F##Loop, RadixScatterWC64Loop<LogF>, \
+                           prepareRadixScatter64Loop<LogF>, NULL, 16, 16, 8);
+
+REGISTER_RADIX_SCATTER(2, 1)
+REGISTER_RADIX_SCATTER(4, 2)
+REGISTER_RADIX_SCATTER(16, 4)
+REGISTER_RADIX_SCATTER(64, 6)
+REGISTER_RADIX_SCATTER(256, 8)
+REGISTER_RADIX_SCATTER(1024, 10)
+REGISTER_RADIX_SCATTER(4096, 12)
+
+#undef REGISTER_RADIX_SCATTER
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Filter and Compaction: compare the random 32-bit values in the first half
+// of the area against a threshold, and store the qualifying values compactly
+// into the second half, as a column scan does. The threshold lets -F
+// <fraction> of the values qualify. Since the output never runs ahead of the
+// input, the vector kernels store full vectors with trailing garbage.
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// threshold below which the values drawn from [0,2^31-1) qualify
+static inline uint32_t filter_threshold()
+{
+    return (uint32_t)(gopt_filter_selectivity * 0x7FFFFFFF);
+}
+
+void prepareFilterCompact32Loop(int thread_num, char* memarea, size_t size)
+{
+    uint32_t* input = (uint32_t*)memarea;
+    size_t n = size / 8;
+
+    LCGRandom rnd(gopt_seed);
+
+    for (size_t i = 0; i < n; ++i)
+        input[i] = (uint32_t)random_below(rnd, 0x7FFFFFFF);
+
+    result_param(thread_num, "selectivity", gopt_filter_selectivity);
+    result_ops(thread_num, "elements", n);
+}
+
+// branch-free compaction: always store, advance only on qualifying values
+// (C version)
+void FilterCompact32Loop(char* memarea, size_t size, size_t repeats)
+{
+    const uint32_t* input = (const uint32_t*)memarea;
+    uint32_t* output = (uint32_t*)(memarea + size / 2);
+    size_t n = size / 8;
+    uint32_t threshold = filter_threshold();
+
+    do {
+        size_t k = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint32_t value = input[i];
+            output[k] = value;
+            k += (value < threshold);
+        }
+        keep_value(k);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_PREPARE(FilterCompact32Loop, prepareFilterCompact32Loop, NULL, 4, 8, 16);
+
+#if __x86_64__
+
+// Lookup tables of the permute-based compaction: for each compare mask the
+// pshufb byte shuffle of 4 lanes, its population count, and the vpermd lane
+// permutation of 8 lanes, moving the selected lanes to the front.
+struct FilterCompactTables
+{
+    uint8_t     shuffle4[16][16] __attribute__((aligned(16)));
+    uint8_t     count4[16];
+    uint32_t    permute8[256][8] __attribute__((aligned(32)));
+
+    FilterCompactTables()
+    {
+        for (unsigned mask = 0; mask < 16; ++mask)
+        {
+            unsigned k = 0;
+            for (unsigned lane = 0; lane < 4; ++lane) {
+                if (!(mask & (1 << lane))) continue;
+                for (unsigned b = 0; b < 4; ++b)
+                    shuffle4[mask][4 * k + b] = 4 * lane + b;
+                ++k;
+            }
+            count4[mask] = k;
+            for ( ; k < 4; ++k)
+                for (unsigned b = 0; b < 4; ++b)
+                    shuffle4[mask][4 * k + b] = 0x80;
+        }
+
+        for (unsigned mask = 0; mask < 256; ++mask)
+        {
+            unsigned k = 0;
+            for (unsigned lane = 0; lane < 8; ++lane)
+                if (mask & (1 << lane)) permute8[mask][k++] = lane;
+            for ( ; k < 8; ++k)
+                permute8[mask][k] = 0;
+        }
+    }
+};
+
+static const FilterCompactTables g_filter_tables;
+
+// The compiler has no mask registers unless it targets AVX-512 itself, and
+// then refuses them as clobbers.
+#if __AVX512F__
+#define FILTER_CLOBBER_K1 "k1",
+#else
+#define FILTER_CLOBBER_K1
+#endif
+
+// 128-bit compare, movmskps and pshufb compaction of 4 values per step
+// (SSSE3 assembler)
+void FilterCompact128Loop(char* memarea, size_t size, size_t repeats)
+{
+    char* output = memarea + size / 2;
+    uint32_t threshold = filter_threshold();
+
+    asm volatile(
+        "movd   %[thr], %%xmm7 \n"
+        "pshufd $0, %%xmm7, %%xmm7 \n"
+        "1: \n" // start of repeat loop
+        "mov    %[memarea], %%rsi \n"   // rsi = input pointer
+        "mov    %[output], %%rdi \n"    // rdi = output cursor
+        "2: \n" // start of filter loop
+        "movdqa (%%rsi), %%xmm0 \n"
+        "movdqa %%xmm7, %%xmm1 \n"
+        "pcmpgtd %%xmm0, %%xmm1 \n"
+        "movmskps %%xmm1, %%eax \n"
+        "movzbl (%[count],%%rax), %%ecx \n"
+        "shl    $4, %%eax \n"
+        "pshufb (%[shuffle],%%rax), %%xmm0 \n"
+        "movdqu %%xmm0, (%%rdi) \n"
+        "lea    (%%rdi,%%rcx,4), %%rdi \n"
+        "add    $16, %%rsi \n"
+        // test filter loop condition
+        "cmp    %[output], %%rsi \n"    // compare to end of input
+        "jb     2b \n"
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [output] "r" (output), [thr] "r" (threshold),
+          [shuffle] "r" (g_filter_tables.shuffle4), [count] "r" (g_filter_tables.count4)
+        : "rax", "rcx", "rsi", "rdi", "xmm0", "xmm1", "xmm7", "cc", "memory");
+}
+
+REGISTER_PREPARE(FilterCompact128Loop, prepareFilterCompact32Loop, "ssse3", 4, 8, 16);
+
+// 256-bit compare, vmovmskps and vpermd compaction of 8 values per step
+// (AVX2 assembler)
+void FilterCompact256Loop(char* memarea, size_t size, size_t repeats)
+{
+    char* output = memarea + size / 2;
+    uint32_t threshold = filter_threshold();
+
+    asm volatile(
+        "vmovd  %[thr], %%xmm7 \n"
+        "vpbroadcastd %%xmm7, %%ymm7 \n"
+        "1: \n" // start of repeat loop
+        "mov    %[memarea], %%rsi \n"   // rsi = input pointer
+        "mov    %[output], %%rdi \n"    // rdi = output cursor
+        "2: \n" // start of filter loop
+        "vmovdqa (%%rsi), %%ymm0 \n"
+        "vpcmpgtd %%ymm0, %%ymm7, %%ymm1 \n"
+        "vmovmskps %%ymm1, %%eax \n"
+        "popcnt %%eax, %%ecx \n"
+        "shl    $5, %%eax \n"
+        "vmovdqa (%[permute],%%rax), %%ymm2 \n"
+        "vpermd %%ymm0, %%ymm2, %%ymm0 \n"
+        "vmovdqu %%ymm0, (%%rdi) \n"
+        "lea    (%%rdi,%%rcx,4), %%rdi \n"
+        "add    $32, %%rsi \n"
+        // test filter loop condition
+        "cmp    %[output], %%rsi \n"    // compare to end of input
+        "jb     2b \n"
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        "vzeroupper \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [output] "r" (output), [thr] "r" (threshold),
+          [permute] "r" (g_filter_tables.permute8)
+        : "rax", "rcx", "rsi", "rdi", "xmm0", "xmm1", "xmm2", "xmm7", "cc", "memory");
+}
+
+REGISTER_PREPARE(FilterCompact256Loop, prepareFilterCompact32Loop, "avx2", 4, 8, 16);
+
+// 512-bit compare into a mask register and vpcompressd compaction of 16
+// values per step (AVX-512 assembler)
+void FilterCompact512Loop(char* memarea, size_t size, size_t repeats)
+{
+    char* output = memarea + size / 2;
+    uint32_t threshold = filter_threshold();
+
+    asm volatile(
+        "vpbroadcastd %[thr], %%zmm7 \n"
+        "1: \n" // start of repeat loop
+        "mov    %[memarea], %%rsi \n"   // rsi = input pointer
+        "mov    %[output], %%rdi \n"    // rdi = output cursor
+        "2: \n" // start of filter loop
+        "vmovdqu32 (%%rsi), %%zmm0 \n"   // areas are only 32 byte aligned
+        "vpcmpgtd %%zmm0, %%zmm7, %%k1 \n"
+        "vpcompressd %%zmm0, %%zmm1%{%%k1%}%{z%} \n"
+        "vmovdqu32 %%zmm1, (%%rdi) \n"
+        "kmovw  %%k1, %%eax \n"
+        "popcnt %%eax, %%ecx \n"
+        "lea    (%%rdi,%%rcx,4), %%rdi \n"
+        "add    $64, %%rsi \n"
+        // test filter loop condition
+        "cmp    %[output], %%rsi \n"    // compare to end of input
+        "jb     2b \n"
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        "vzeroupper \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [output] "r" (output), [thr] "r" (threshold)
+        : FILTER_CLOBBER_K1 "rax", "rcx", "rsi", "rdi", "xmm0", "xmm1", "xmm7", "cc", "memory");
+}
+
+REGISTER_PREPARE(FilterCompact512Loop, prepareFilterCompact32Loop, "avx512f", 4, 8, 16);
+
+#undef FILTER_CLOBBER_K1
+
+#endif // __x86_64__
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Prefix Sums: inclusive scan of the random integers in the first half of the
+// area into the second half. The plain and Vec kernels scan each thread's area
+// on its own, while in the TwoPass and LookBack kernels all threads cooperate
+// on one scan of the array formed by their areas.
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+template <typename Type>
+void preparePrefixSumLoop(int thread_num, char* memarea, size_t size)
+{
+    Type* input = (Type*)memarea;
+    size_t n = size / 2 / sizeof(Type);
+
+    LCGRandom rnd(gopt_seed + thread_num);
+
+    for (size_t i = 0; i < n; ++i)
+        input[i] = (Type)rnd();
+
+    result_ops(thread_num, "elements", n);
+}
+
+// return the sum of n values
+template <typename Type>
+static inline Type prefix_reduce(const Type* input, size_t n)
+{
+    Type sum = 0;
+    for (size_t i = 0; i < n; ++i)
+        sum += input[i];
+    return sum;
+}
+
+// write the inclusive prefix sums of n values plus the carry, return the last
+template <typename Type>
+static inline Type prefix_scan(const Type* input, Type* output, size_t n, Type sum)
+{
+    for (size_t i = 0; i < n; ++i)
+        output[i] = sum += input[i];
+    return sum;
+}
+
+// sequential scan of each thread's area (C version)
+template <typename Type>
+void PrefixSumLoop(char* memarea, size_t size, size_t repeats)
+{
+    const Type* input = (const Type*)memarea;
+    Type* output = (Type*)(memarea + size / 2);
+    size_t n = size / 2 / sizeof(Type);
+
+    do {
+        prefix_scan<Type>(input, output, n, 0);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_PREPARE_NAMED(PrefixSum32Loop, PrefixSumLoop<uint32_t>, preparePrefixSumLoop<uint32_t>, NULL, 8, 8, 8);
+REGISTER_PREPARE_NAMED(PrefixSum64Loop, PrefixSumLoop<uint64_t>, preparePrefixSumLoop<uint64_t>, NULL, 16, 16, 4);
+
+#if __x86_64__
+
+// in-register scans of two 128-bit vectors by shifted adds, the carry chain
+// between steps is a single add of the total of both vectors (SSE2 assembler)
+void PrefixSum32Vec128Loop(char* memarea, size_t size, size_t repeats)
+{
+    char* output = memarea + size / 2;
+
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    %[memarea], %%rsi \n"   // rsi = input pointer
+        "mov    %[output], %%rdi \n"    // rdi = output pointer
+        "pxor   %%xmm7, %%xmm7 \n"      // xmm7 = carry in all lanes
+        "2: \n" // start of scan loop
+        "movdqa 0*16(%%rsi), %%xmm0 \n"
+        "movdqa 1*16(%%rsi), %%xmm1 \n"
+        // scan within each vector
+        "movdqa %%xmm0, %%xmm2 \n"
+        "movdqa %%xmm1, %%xmm3 \n"
+        "pslldq $4, %%xmm2 \n"
+        "pslldq $4, %%xmm3 \n"
+        "paddd  %%xmm2, %%xmm0 \n"
+        "paddd  %%xmm3, %%xmm1 \n"
+        "movdqa %%xmm0, %%xmm2 \n"
+        "movdqa %%xmm1, %%xmm3 \n"
+        "pslldq $8, %%xmm2 \n"
+        "pslldq $8, %%xmm3 \n"
+        "paddd  %%xmm2, %%xmm0 \n"
+        "paddd  %%xmm3, %%xmm1 \n"
+        // add the total of the first vector to the second
+        "pshufd $0xFF, %%xmm0, %%xmm2 \n"
+        "paddd  %%xmm2, %%xmm1 \n"
+        "pshufd $0xFF, %%xmm1, %%xmm3 \n"
+        // add the carry and advance it by the total of both
+        "paddd  %%xmm7, %%xmm0 \n"
+        "paddd  %%xmm7, %%xmm1 \n"
+        "paddd  %%xmm3, %%xmm7 \n"
+        "movdqa %%xmm0, 0*16(%%rdi) \n"
+        "movdqa %%xmm1, 1*16(%%rdi) \n"
+        "add    $32, %%rsi \n"
+        "add    $32, %%rdi \n"
+        // test scan loop condition
+        "cmp    %[output], %%rsi \n"    // compare to end of input
+        "jb     2b \n"
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [output] "r" (output)
+        : "rsi", "rdi", "xmm0", "xmm1", "xmm2", "xmm3", "xmm7", "cc", "memory");
+}
+
+REGISTER_PREPARE(PrefixSum32Vec128Loop, preparePrefixSumLoop<uint32_t>, NULL, 8, 8, 8);
+
+// in-register scans of two 128-bit vectors of 64-bit values (SSE2 assembler)
+void PrefixSum64Vec128Loop(char* memarea, size_t size, size_t repeats)
+{
+    char* output = memarea + size / 2;
+
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    %[memarea], %%rsi \n"   // rsi = input pointer
+        "mov    %[output], %%rdi \n"    // rdi = output pointer
+        "pxor   %%xmm7, %%xmm7 \n"      // xmm7 = carry in all lanes
+        "2: \n" // start of scan loop
+        "movdqa 0*16(%%rsi), %%xmm0 \n"
+        "movdqa 1*16(%%rsi), %%xmm1 \n"
+        // scan within each vector
+        "movdqa %%xmm0, %%xmm2 \n"
+        "movdqa %%xmm1, %%xmm3 \n"
+        "pslldq $8, %%xmm2 \n"
+        "pslldq $8, %%xmm3 \n"
+        "paddq  %%xmm2, %%xmm0 \n"
+        "paddq  %%xmm3, %%xmm1 \n"
+        // add the total of the first vector to the second
+        "pshufd $0xEE, %%xmm0, %%xmm2 \n"
+        "paddq  %%xmm2, %%xmm1 \n"
+        "pshufd $0xEE, %%xmm1, %%xmm3 \n"
+        // add the carry and advance it by the total of both
+        "paddq  %%xmm7, %%xmm0 \n"
+        "paddq  %%xmm7, %%xmm1 \n"
+        "paddq  %%xmm3, %%xmm7 \n"
+        "movdqa %%xmm0, 0*16(%%rdi) \n"
+        "movdqa %%xmm1, 1*16(%%rdi) \n"
+        "add    $32, %%rsi \n"
+        "add    $32, %%rdi \n"
+        // test scan loop condition
+        "cmp    %[output], %%rsi \n"    // compare to end of input
+        "jb     2b \n"
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [output] "r" (output)
+        : "rsi", "rdi", "xmm0", "xmm1", "xmm2", "xmm3", "xmm7", "cc", "memory");
+}
+
+REGISTER_PREPARE(PrefixSum64Vec128Loop, preparePrefixSumLoop<uint64_t>, NULL, 16, 16, 4);
+
+#endif // __x86_64__
+
+// Sums of the threads' areas published by the first pass of the TwoPass scan,
+// each on its own cache line. They are double buffered by the parity of the
+// repeat, such that the threads need only one barrier per repeat.
+static std::vector<uint64_t> g_prefix_partial;
+
+template <typename Type>
+void preparePrefixSumTwoPassLoop(int thread_num, char* memarea, size_t size)
+{
+    preparePrefixSumLoop<Type>(thread_num, memarea, size);
+
+    if (thread_num == 0)
+        g_prefix_partial.assign(2 * g_nthreads * 8, 0);
+}
+
+// reduce each area and publish its sum, then after a barrier scan each area
+// starting with the sums of the preceding ones (C version)
+template <typename Type>
+void PrefixSumTwoPassLoop(char* memarea, size_t size, size_t repeats)
+{
+    const Type* input = (const Type*)memarea;
+    Type* output = (Type*)(memarea + size / 2);
+    size_t n = size / 2 / sizeof(Type);
+    size_t parity = 0;
+
+    do {
+        uint64_t* partial = g_prefix_partial.data() + parity * g_nthreads * 8;
+
+        partial[t_thread_num * 8] = prefix_reduce<Type>(input, n);
+
+        pthread_barrier_wait(&g_barrier);
+
+        Type sum = 0;
+        for (int p = 0; p < t_thread_num; ++p)
+            sum += (Type)partial[p * 8];
+
+        prefix_scan<Type>(input, output, n, sum);
+
+        parity ^= 1;
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_PREPARE_NAMED(PrefixSum32TwoPassLoop, PrefixSumTwoPassLoop<uint32_t>,
+                       preparePrefixSumTwoPassLoop<uint32_t>, NULL, 8, 8, 8);
+REGISTER_PREPARE_NAMED(PrefixSum64TwoPassLoop, PrefixSumTwoPassLoop<uint64_t>,
+                       preparePrefixSumTwoPassLoop<uint64_t>, NULL, 16, 16, 4);
+
+// Status of a tile of the LookBack scan, padded to a cache line: status is
+// four times the repeat number which last wrote it, plus 1 once the aggregate
+// of the tile, or 2 once its inclusive prefix is published.
+struct PrefixSumTile
+{
+    uint64_t    status;
+    uint64_t    aggregate;
+    uint64_t    inclusive;
+    uint64_t    padding[5];
+};
+
+// Tiles of the LookBack scan in scan order, double buffered by the parity of
+// the repeat. Tile i lies in the area of thread i % nthreads, such that all
+// threads progress through the array together.
+static std::vector<PrefixSumTile> g_prefix_tiles;
+
+// number of values in a tile of the LookBack scan, and the number of tiles of
+// each thread, which is at least two
+template <typename Type>
+static inline size_t prefix_tile_size(size_t n)
+{
+    return std::min<size_t>(16384 / sizeof(Type), n / 2);
+}
+
+template <typename Type>
+void preparePrefixSumLookBackLoop(int thread_num, char* memarea, size_t size)
+{
+    preparePrefixSumLoop<Type>(thread_num, memarea, size);
+
+    if (thread_num == 0)
+    {
+        size_t n = size / 2 / sizeof(Type);
+        size_t tile = prefix_tile_size<Type>(n);
+        size_t tiles = (n + tile - 1) / tile;
+
+        PrefixSumTile zero = PrefixSumTile();
+        g_prefix_tiles.assign(2 * g_nthreads * tiles, zero);
+    }
+}
+
+// single pass scan with decoupled look-back: each tile publishes its
+// aggregate, then adds up the aggregates of its predecessors until one has
+// published its inclusive prefix, publishes its own inclusive prefix, and
+// scans its values, which are still in cache (C version)
+template <typename Type>
+void PrefixSumLookBackLoop(char* memarea, size_t size, size_t repeats)
+{
+    const Type* input = (const Type*)memarea;
+    Type* output = (Type*)(memarea + size / 2);
+    size_t n = size / 2 / sizeof(Type);
+    size_t tile = prefix_tile_size<Type>(n);
+    size_t tiles = (n + tile - 1) / tile;
+    size_t nthreads = g_nthreads;
+
+    for (uint64_t repeat = 1; repeat <= repeats; ++repeat)
+    {
+        PrefixSumTile* status = g_prefix_tiles.data() + (repeat % 2) * nthreads * tiles;
+
+        for (size_t j = 0; j < tiles; ++j)
+        {
+            size_t begin = j * tile, end = std::min(begin + tile, n);
+            size_t i = j * nthreads + t_thread_num;
+
+            Type aggregate = prefix_reduce<Type>(input + begin, end - begin);
+            Type sum = 0;
+
+            if (i != 0)
+            {
+                status[i].aggregate = aggregate;
+                __atomic_store_n(&status[i].status, 4 * repeat + 1, __ATOMIC_RELEASE);
+
+                // look back until a predecessor has its inclusive prefix
+                for (size_t k = i - 1; ; --k)
+                {
+                    uint64_t s;
+                    while ((s = __atomic_load_n(&status[k].status, __ATOMIC_ACQUIRE)) / 4 != repeat)
+                        sched_yield();
+
+                    if (s % 4 == 2) {
+                        sum += (Type)status[k].inclusive;
+                        break;
+                    }
+                    sum += (Type)status[k].aggregate;
+                }
+            }
+
+            status[i].inclusive = sum + aggregate;
+            __atomic_store_n(&status[i].status, 4 * repeat + 2, __ATOMIC_RELEASE);
+
+            prefix_scan<Type>(input + begin, output + begin, end - begin, sum);
+        }
+    }
+}
+
+REGISTER_PREPARE_NAMED(PrefixSum32LookBackLoop, PrefixSumLookBackLoop<uint32_t>,
+                       preparePrefixSumLookBackLoop<uint32_t>, NULL, 8, 8, 8);
+REGISTER_PREPARE_NAMED(PrefixSum64LookBackLoop, PrefixSumLookBackLoop<uint64_t>,
+                       preparePrefixSumLookBackLoop<uint64_t>, NULL, 16, 16, 4);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Matrix Transpose: transpose the largest square matrix of 64-bit values with
+// a multiple of eight rows fitting into the first half of the area into the
+// second half. The blocked kernels transpose square tiles of -T <elements>.
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// return the second matrix in the second half of the area, starting on a
+// cache line as the non-temporal kernel streams whole lines of its rows, and
+// the number of rows and columns dim of the matrices fitting after it
+static inline uint64_t* transpose_dst(char* memarea, size_t size, size_t& dim)
+{
+    char* begin = (char*)(((uintptr_t)(memarea + size / 2) + 63) & ~(uintptr_t)63);
+    dim = (size_t)sqrt((double)((memarea + size - begin) / 8)) & ~(size_t)7;
+    return (uint64_t*)begin;
+}
+
+void prepareTranspose64Loop(int thread_num, char* memarea, size_t size)
+{
+    uint64_t* src = (uint64_t*)memarea;
+    size_t dim;
+    transpose_dst(memarea, size, dim);
+
+    for (size_t i = 0; i < dim * dim; ++i)
+        src[i] = i;
+
+    result_param(thread_num, "dim", dim);
+    result_ops(thread_num, "elements", dim * dim);
+    // only the two matrices are accessed, not the remainder of the area
+    result_touched(thread_num, dim * dim * 16);
+}
+
+void prepareTransposeBlocked64Loop(int thread_num, char* memarea, size_t size)
+{
+    prepareTranspose64Loop(thread_num, memarea, size);
+
+    result_param(thread_num, "tile", gopt_transpose_tile);
+}
+
+// read rows and write columns (C version)
+void TransposeNaive64Loop(char* memarea, size_t size, size_t repeats)
+{
+    const uint64_t* src = (const uint64_t*)memarea;
+    size_t dim;
+    uint64_t* dst = transpose_dst(memarea, size, dim);
+
+    do {
+        for (size_t i = 0; i < dim; ++i)
+            for (size_t j = 0; j < dim; ++j)
+                dst[j * dim + i] = src[i * dim + j];
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_PREPARE(TransposeNaive64Loop, prepareTranspose64Loop, NULL, 16, 16, 64);
+
+// transpose tile by tile, such that the lines of a tile's columns stay in
+// cache until they are filled (C version)
+void TransposeBlocked64Loop(char* memarea, size_t size, size_t repeats)
+{
+    const uint64_t* src = (const uint64_t*)memarea;
+    size_t dim;
+    uint64_t* dst = transpose_dst(memarea, size, dim);
+    size_t tile = gopt_transpose_tile;
+
+    do {
+        for (size_t ii = 0; ii < dim; ii += tile)
+        {
+            size_t iend = std::min(ii + tile, dim);
+
+            for (size_t jj = 0; jj < dim; jj += tile)
+            {
+                size_t jend = std::min(jj + tile, dim);
+
+                for (size_t i = ii; i < iend; ++i)
+                    for (size_t j = jj; j < jend; ++j)
+                        dst[j * dim + i] = src[i * dim + j];
+            }
+        }
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_PREPARE(TransposeBlocked64Loop, prepareTransposeBlocked64Loop, NULL, 16, 16, 64);
+
+// transpose each tile into a buffer, then write the buffer's rows as whole
+// lines with non-temporal stores, bypassing the cache (C version)
+void TransposeBlockedNT64Loop(char* memarea, size_t size, size_t repeats)
+{
+    const uint64_t* src = (const uint64_t*)memarea;
+    size_t dim;
+    uint64_t* dst = transpose_dst(memarea, size, dim);
+    size_t tile = gopt_transpose_tile;
+
+    char* aux = thread_auxarea(tile * tile * sizeof(uint64_t) + 64);
+    uint64_t* buffer = (uint64_t*)(((uintptr_t)aux + 63) & ~(uintptr_t)63);
+
+    do {
+        for (size_t ii = 0; ii < dim; ii += tile)
+        {
+            size_t iend = std::min(ii + tile, dim);
+
+            for (size_t jj = 0; jj < dim; jj += tile)
+            {
+                size_t jend = std::min(jj + tile, dim);
+
+                for (size_t i = ii; i < iend; ++i)
+                    for (size_t j = jj; j < jend; ++j)
+                        buffer[(j - jj) * tile + (i - ii)] = src[i * dim + j];
+
+                for (size_t j = jj; j < jend; ++j)
+                    for (size_t i = ii; i < iend; i += 8)
+                        stream_line64(dst + j * dim + i, buffer + (j - jj) * tile + (i - ii));
+            }
+        }
+
+        stream_fence();
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_PREPARE(TransposeBlockedNT64Loop, prepareTransposeBlocked64Loop, NULL, 16, 16, 64);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Stencils: Jacobi sweeps over grids of doubles in the first half of the area
+// into the second half, with 128-bit vectors via the compiler's vector
+// extension. The bandwidth counts the 16 useful bytes per computed interior
+// grid point, the opsrate the bytes moved according to a cache line traffic
+// model: the neighbouring rows and planes are reused only while three of them
+// fit into half of the L2 cache, and stores allocate their lines.
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// two doubles in a 128-bit vector, loaded from any 8 byte aligned address
+typedef double v2df __attribute__((vector_size(16), aligned(8)));
+
+// largest edge length of a grid of Dim dimensions with at most n points
+template <int Dim>
+static inline size_t stencil_dim(size_t n)
+{
+    size_t dim = (size_t)pow((double)n, 1.0 / Dim);
+
+    while (pow((double)(dim + 1), Dim) <= (double)n) ++dim;
+    while (pow((double)dim, Dim) > (double)n) --dim;
+
+    return dim;
+}
+
+// return bytes moved per grid point when sweeping rows of dim points with the
+// neighbours at distance dim, and dim^2 in three dimensions
+template <int Dim>
+static inline size_t stencil_traffic(size_t dim)
+{
+    size_t layer = g_layer_cachesize / 2;
+    size_t reads = 1;
+
+    if (Dim >= 2 && 3 * dim * sizeof(double) > layer) reads += 2;
+    if (Dim >= 3 && 3 * dim * dim * sizeof(double) > layer) reads += 2;
+
+    return (reads + 2) * sizeof(double);
+}
+
+template <int Dim>
+void prepareStencil64Loop(int thread_num, char* memarea, size_t size)
+{
+    double* in = (double*)memarea;
+    size_t n = size / 16;
+    size_t dim = stencil_dim<Dim>(n);
+    // only the interior points of the grid are computed
+    size_t points = (size_t)pow((double)(dim - 2), Dim);
+
+    for (size_t i = 0; i < n; ++i)
+        in[i] = (double)(i % 64);
+
+    result_param(thread_num, "dim", dim);
+    result_param(thread_num, "layercache", g_layer_cachesize);
+    result_ops(thread_num, "traffic", points * stencil_traffic<Dim>(dim));
+    result_touched(thread_num, points * 16);
+}
+
+// out[i] = a * c[i] + b * (c[i-1] + c[i+1] + nb[0][i] + ... + nb[K-1][i])
+// for i in [begin,end), with the row c and the K neighbouring rows nb
+template <int K>
+static inline void stencil_row(double* out, const double* c, const double* const* nb,
+                               size_t begin, size_t end, double a, double b)
+{
+    const v2df va = { a, a }, vb = { b, b };
+
+    size_t i = begin;
+    for ( ; i + 2 <= end; i += 2)
+    {
+        v2df sum = *(const v2df*)(c + i - 1) + *(const v2df*)(c + i + 1);
+        for (int k = 0; k < K; ++k)
+            sum += *(const v2df*)(nb[k] + i);
+        *(v2df*)(out + i) = va * *(const v2df*)(c + i) + vb * sum;
+    }
+    for ( ; i < end; ++i)
+    {
+        double sum = c[i - 1] + c[i + 1];
+        for (int k = 0; k < K; ++k)
+            sum += nb[k][i];
+        out[i] = a * c[i] + b * sum;
+    }
+}
+
+// 3-point stencil on a line (C version)
+void Stencil1D64Loop(char* memarea, size_t size, size_t repeats)
+{
+    const double* in = (const double*)memarea;
+    double* out = (double*)(memarea + size / 2);
+    size_t n = size / 16;
+
+    do {
+        stencil_row<0>(out, in, NULL, 1, n - 1, 0.5, 0.25);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_PREPARE(Stencil1D64Loop, prepareStencil64Loop<1>, NULL, 16, 16, 64);
+
+// 5-point stencil on a square (C version)
+void Stencil2D64Loop(char* memarea, size_t size, size_t repeats)
+{
+    const double* in = (const double*)memarea;
+    double* out = (double*)(memarea + size / 2);
+    size_t dim = stencil_dim<2>(size / 16);
+
+    do {
+        for (size_t y = 1; y < dim - 1; ++y)
+        {
+            const double* nb[2] = { in + (y - 1) * dim, in + (y + 1) * dim };
+            stencil_row<2>(out + y * dim, in + y * dim, nb, 1, dim - 1, 0.2, 0.2);
+        }
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_PREPARE(Stencil2D64Loop, prepareStencil64Loop<2>, NULL, 16, 16, 64);
+
+// 7-point stencil on a cube (C version)
+void Stencil3D64Loop(char* memarea, size_t size, size_t repeats)
+{
+    const double* in = (const double*)memarea;
+    double* out = (double*)(memarea + size / 2);
+    size_t dim = stencil_dim<3>(size / 16);
+    size_t plane = dim * dim;
+
+    do {
+        for (size_t z = 1; z < dim - 1; ++z)
+        {
+            for (size_t y = 1; y < dim - 1; ++y)
+            {
+                size_t row = z * plane + y * dim;
+                const double* nb[4] = { in + row - dim, in + row + dim,
+                                        in + row - plane, in + row + plane };
+                stencil_row<4>(out + row, in + row, nb, 1, dim - 1, 0.4, 0.1);
+            }
+        }
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_PREPARE(Stencil3D64Loop, prepareStencil64Loop<3>, NULL, 16, 16, 64);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Sparse Matrix-Vector Multiplication: y = A x with a square matrix A of -N
+// <count> nonzeros per row in compressed sparse row format. Values, x, y, row
+// pointers and column indices fill the area, such that the bandwidth counts
+// each byte once, and the opsrate the floating point operations.
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// column patterns of the sparse matrices
+enum SpMVPattern { SPMV_BANDED, SPMV_RANDOM, SPMV_POWERLAW };
+
+// arrays of a CSR matrix of as many rows as fit into the area. The nonzeros
+// per row are bounded by the number of rows, such that small areas still hold
+// a square matrix instead of no rows at all.
+struct SpMVLayout
+{
+    size_t      rows, nnz;
+    double*     values;
+    double*     x;
+    double*     y;
+    uint64_t*   rowptr;
+    uint32_t*   colidx;
+
+    static size_t fit_rows(size_t size, size_t nnz)
+    {
+        return (size - sizeof(uint64_t)) / (nnz * (sizeof(double) + sizeof(uint32_t)) +
+                                            2 * sizeof(double) + sizeof(uint64_t));
+    }
+
+    SpMVLayout(char* memarea, size_t size)
+    {
+        nnz = std::min<uint64_t>(gopt_spmv_nnz, (size_t)sqrt((double)size / 12) + 1);
+        while (nnz > 1 && fit_rows(size, nnz) < nnz) --nnz;
+        rows = fit_rows(size, nnz);
+
+        values = (double*)memarea;
+        x = values + rows * nnz;
+        y = x + rows;
+        rowptr = (uint64_t*)(y + rows);
+        colidx = (uint32_t*)(rowptr + rows + 1);
+    }
+};
+
+template <int Pattern>
+void prepareSpMV64Loop(int thread_num, char* memarea, size_t size)
+{
+    SpMVLayout m(memarea, size);
+
+    LCGRandom rnd(gopt_seed);
+    ZipfRandom zrnd(gopt_seed, std::max<size_t>(m.rows, 1), gopt_zipf_exponent);
+    uint64_t scatter = scatter_factor(std::max<size_t>(m.rows, 1));
+
+    for (size_t r = 0; r < m.rows; ++r)
+    {
+        m.rowptr[r] = r * m.nnz;
+        m.x[r] = 1.0 / (r + 1);
+
+        uint32_t* col = m.colidx + r * m.nnz;
+
+        for (size_t k = 0; k < m.nnz; ++k)
+        {
+            m.values[r * m.nnz + k] = 1.0;
+
+            if (Pattern == SPMV_BANDED) // band around the diagonal, wrapped
+                col[k] = (r + m.rows * m.nnz - m.nnz / 2 + k) % m.rows;
+            else if (Pattern == SPMV_RANDOM)
+                col[k] = random_below(rnd, m.rows);
+            else // scattered ranks of a Zipf distribution
+                col[k] = mulmod(zrnd() - 1, scatter, m.rows);
+        }
+
+        std::sort(col, col + m.nnz);
+    }
+    m.rowptr[m.rows] = m.rows * m.nnz;
+
+    result_param(thread_num, "nnz", m.nnz);
+    if (Pattern == SPMV_POWERLAW)
+        result_param(thread_num, "zipf", gopt_zipf_exponent);
+    result_ops(thread_num, "flops", 2 * m.rows * m.nnz);
+}
+
+// stream values and column indices, and gather from x (C version)
+void SpMV64Loop(char* memarea, size_t size, size_t repeats)
+{
+    SpMVLayout m(memarea, size);
+
+    do {
+        for (size_t r = 0; r < m.rows; ++r)
+        {
+            double sum = 0;
+            for (uint64_t k = m.rowptr[r]; k < m.rowptr[r + 1]; ++k)
+                sum += m.values[k] * m.x[m.colidx[k]];
+            m.y[r] = sum;
+        }
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_PREPARE_NAMED(SpMVBanded64Loop, SpMV64Loop, prepareSpMV64Loop<SPMV_BANDED>, NULL, 8, 8, 128);
+REGISTER_PREPARE_NAMED(SpMVRandom64Loop, SpMV64Loop, prepareSpMV64Loop<SPMV_RANDOM>, NULL, 8, 8, 128);
+REGISTER_PREPARE_NAMED(SpMVPowerLaw64Loop, SpMV64Loop, prepareSpMV64Loop<SPMV_POWERLAW>, NULL, 8, 8, 128);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// LZ Decompression: replay a synthetic compressed stream of tokens, each a
+// literal run followed by a match, which copies bytes from a distance back in
+// the output written so far, overlapping when the distance is shorter than
+// the match. The area is the window and its size the output of a repeat.
+// Literal runs and match lengths are geometric with the means given by -C,
+// distances log-uniform up to the window or the maximum of -C.
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// a token of the compressed stream, followed by its literal bytes
+struct LZToken
+{
+    uint16_t    literals;
+    uint16_t    length;
+    uint32_t    distance;
+
+    // largest match distance a token holds
+    static const uint64_t maxdist = 0xFFFFFFFF;
+};
+
+const uint64_t LZToken::maxdist;
+
+// parse the -C specification "literals,match,maxdist"
+static bool parse_lz_spec(const char* spec)
+{
+    char* endp;
+
+    double literals = strtod(spec, &endp);
+    if (endp == spec || *endp != ',' || literals < 0) return false;
+    spec = endp + 1;
+
+    double match = strtod(spec, &endp);
+    if (endp == spec || *endp != ',' || match < 4) return false;
+    spec = endp + 1;
+
+    uint64_t maxdist = strtoull(spec, &endp, 10);
+    if (endp == spec) return false;
+    spec = endp;
+
+    uint64_t unit = 1;
+    if (*spec == 'K') unit = 1024, ++spec;
+    else if (*spec == 'M') unit = 1024*1024, ++spec;
+    else if (*spec == 'G') unit = 1024*1024*1024LLU, ++spec;
+    if (*spec != 0) return false;
+
+    // tokens hold 32-bit distances
+    if (maxdist > LZToken::maxdist / unit) return false;
+    maxdist *= unit;
+
+    gopt_lz_literals = literals;
+    gopt_lz_match = match;
+    gopt_lz_maxdist = maxdist;
+    return true;
+}
+
+// Auxiliary memory of the LZ kernels: the length of the compressed stream,
+// which is replayed from its start if it ends before the area is filled, and
+// the stream padded for copies of whole words.
+struct LZStreamAux
+{
+    uint64_t    bytes;
+    uint8_t     stream[8];
+
+    // limit of the compressed stream, such that it stays in a reasonable
+    // proportion to the memory area
+    static const size_t maxbytes = 16 * 1024 * 1024;
+};
+
+// geometric random number of failures before a success, with mean m
+static inline uint64_t lz_geometric(LCGRandom& rnd, double m)
+{
+    if (m <= 0) return 0;
+    double u = ((rnd() >> 11) + 1) * (1.0 / 9007199254740993.0);
+    return (uint64_t)(log(u) / log(m / (m + 1)));
+}
+
+void prepareLZDecodeLoop(int thread_num, char* /* memarea */, size_t size)
+{
+    std::vector<uint8_t> stream;
+    LCGRandom rnd(gopt_seed);
+
+    uint64_t window = gopt_lz_maxdist ? std::min<uint64_t>(gopt_lz_maxdist, size) : size;
+    window = std::min<uint64_t>(window, LZToken::maxdist);
+
+    for (uint64_t pos = 0; pos < size && stream.size() < LZStreamAux::maxbytes; )
+    {
+        LZToken t;
+        uint64_t literals = std::min<uint64_t>(lz_geometric(rnd, gopt_lz_literals), 0xFFFF);
+        if (pos == 0 && literals == 0) literals = 1;
+        t.literals = literals;
+        pos += literals;
+
+        uint64_t length = std::min<uint64_t>(4 + lz_geometric(rnd, gopt_lz_match - 4), 0xFFFF);
+        t.length = length;
+
+        // log-uniform distance in [1,maxdist]
+        uint64_t maxdist = std::min<uint64_t>(pos, window);
+        double u = (rnd() >> 11) * (1.0 / 9007199254740992.0);
+        t.distance = std::max<uint64_t>(1, std::min<uint64_t>((uint64_t)exp(u * log((double)maxdist + 1)), maxdist));
+        pos += length;
+
+        const uint8_t* tp = (const uint8_t*)&t;
+        stream.insert(stream.end(), tp, tp + sizeof(t));
+        for (uint64_t i = 0; i < literals; ++i)
+            stream.push_back((uint8_t)rnd());
+    }
+
+    LZStreamAux* aux = (LZStreamAux*)thread_auxarea(sizeof(LZStreamAux) + stream.size());
+    aux->bytes = stream.size();
+    memcpy(aux->stream, stream.data(), stream.size());
+
+    result_param(thread_num, "lz", gopt_lz_spec);
+}
+
+// copy n bytes from src to out in whole words, overshooting by up to seven
+// bytes if they fit before end, which is valid for overlapping copies as long
+// as src is at least a word behind out
+static inline void lz_copy(uint8_t* out, const uint8_t* src, size_t n, const uint8_t* end)
+{
+    if ((size_t)(end - out) >= n + 8) {
+        for (size_t i = 0; i < n; i += 8)
+            memcpy(out + i, src + i, 8);
+    }
+    else {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = src[i];
+    }
+}
+
+// decode the stream with word copies, and byte copies for matches repeating
+// a pattern shorter than a word (C version)
+void LZDecodeLoop(char* memarea, size_t size, size_t repeats)
+{
+    const LZStreamAux* aux = (const LZStreamAux*)t_auxarea;
+    const uint8_t* begin = aux->stream;
+    const uint8_t* stream_end = begin + aux->bytes;
+
+    do {
+        uint8_t* out = (uint8_t*)memarea;
+        const uint8_t* end = out + size;
+        const uint8_t* in = begin;
+
+        while (out < end)
+        {
+            if (in == stream_end) in = begin;
+
+            LZToken t;
+            memcpy(&t, in, sizeof(t));
+            in += sizeof(t);
+
+            size_t literals = std::min<size_t>(t.literals, end - out);
+            lz_copy(out, in, literals, end);
+            out += literals, in += t.literals;
+
+            size_t length = std::min<size_t>(t.length, end - out);
+            if (t.distance >= 8)
+                lz_copy(out, out - t.distance, length, end);
+            else
+                for (size_t i = 0; i < length; ++i)
+                    out[i] = out[i - t.distance];
+            out += length;
+        }
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_PREPARE(LZDecodeLoop, prepareLZDecodeLoop, NULL, 8, 8, 16);
+
+// -----------------------------------------------------------------------------
@@ -540,4 +540,123 @@ void PermRead32UnrollLoop(char* memarea, size_t, size_t repeats)
 
 REGISTER_PERM(PermRead32UnrollLoop, 4);
 
+// follow 32-bit permutation of one pointer per page: probes the TLB reach
+REGISTER_PERM_LAYOUT(PermPageRead32SimpleLoop, PermRead32SimpleLoop, 4, PERM_PAGE);
+
+// follow 32-bit cycle over all cache lines: pages in random order with their
+// lines in order, or pages in order with their lines in random order. Compared
+// to the fully random cycle this separates TLB walk from cache miss cost.
+REGISTER_PERM_LAYOUT(PermPageRandLineSeqRead32SimpleLoop, PermRead32SimpleLoop, 4, PERM_PAGE_RANDOM);
+REGISTER_PERM_LAYOUT(PermPageSeqLineRandRead32SimpleLoop, PermRead32SimpleLoop, 4, PERM_LINE_RANDOM);
+
+// follow Chains independent 32-bit cycles at once, interleaved over the whole
+// area, to measure memory-level parallelism. The chains are kept in
+// registers r0-r3, all return to their first pointer together. (Assembler version)
+template <int Chains>
+void PermRead32ChainsLoop(char* memarea, size_t, size_t repeats)
+{
+    asm volatile(
+        "mov    ip, %[memarea] \n"      // ip = first pointer of chain
+        ".irp   r, 0,1,2,3 \n"
+        ".if    \\r < %c[chains] \n"
+        "mov    r\\r, ip \n"
+        "add    ip, ip, %[stride] \n"   // advance to next chain
+        ".endif \n"
+        ".endr \n"
+        "1: \n" // start of repeat loop
+        "2: \n" // start of loop
+        ".irp   r, 0,1,2,3 \n"
+        ".if    \\r < %c[chains] \n"
+        "ldr    r\\r, [r\\r] \n"
+        ".endif \n"
+        ".endr \n"
+        // test loop condition
+        "cmp    r0, %[memarea] \n"      // compare to first iterator
+        "bne    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [stride] "r" (g_perm_stride), [chains] "i" (Chains)
+        : "r0", "r1", "r2", "r3", "ip", "cc", "memory");
+}
+
+REGISTER_PERM_CHAINS(PermRead32Chains2Loop, PermRead32ChainsLoop<2>, NULL, 4, 2);
+REGISTER_PERM_CHAINS(PermRead32Chains4Loop, PermRead32ChainsLoop<4>, NULL, 4, 4);
+
+// follow Chains independent 32-bit cycles at once, for more chains than free
+// registers: the chains are kept in an array on the stack, which adds an L1
+// load and store to each step. (Assembler version)
+template <int Chains>
+void PermRead32ChainsStackLoop(char* memarea, size_t, size_t repeats)
+{
+    char* chain[Chains];
+
+    for (int c = 0; c < Chains; ++c)
+        chain[c] = memarea + c * g_perm_stride;
+
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "2: \n" // start of loop
+        ".set   .Lchain, 0 \n"
+        ".rept  %c[chains] \n"
+        "ldr    ip, [%[chain], #.Lchain] \n"
+        "ldr    ip, [ip] \n"
+        "str    ip, [%[chain], #.Lchain] \n"
+        ".set   .Lchain, .Lchain + 4 \n"
+        ".endr \n"
+        // test loop condition
+        "ldr    ip, [%[chain]] \n"
+        "cmp    ip, %[memarea] \n"      // compare to first iterator
+        "bne    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [chain] "r" (chain), [chains] "i" (Chains)
+        : "ip", "cc", "memory");
+}
+
+REGISTER_PERM_CHAINS(PermRead32Chains8Loop, PermRead32ChainsStackLoop<8>, NULL, 4, 8);
+REGISTER_PERM_CHAINS(PermRead32Chains16Loop, PermRead32ChainsStackLoop<16>, NULL, 4, 16);
+REGISTER_PERM_CHAINS(PermRead32Chains32Loop, PermRead32ChainsStackLoop<32>, NULL, 4, 32);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Instruction Fetching
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// fill the area with straight-line NOPs followed by a return (ARM state)
+void prepareScanExec32NopLoop(int, char* memarea, size_t size)
+{
+    uint32_t* begin = (uint32_t*)memarea;
+    uint32_t* end = begin + size / sizeof(uint32_t) - 1;
+
+    for (uint32_t* p = begin; p < end; ++p)
+        *p = 0xE1A00000;                // mov r0, r0
+
+    *end = 0xE12FFF1E;                  // bx lr
+
+    clear_icache(memarea, size);
+}
+
+// call the generated straight-line code (Assembler version)
+void ScanExec32NopLoop(char* memarea, size_t, size_t repeats)
+{
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "blx    %[memarea] \n"          // run through the code area
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea)
+        : "lr", "cc", "memory");
+}
+
+REGISTER_EXEC(ScanExec32NopLoop, prepareScanExec32NopLoop, NULL, 4);
+
 // -----------------------------------------------------------------------------
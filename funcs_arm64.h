@@ -550,6 +550,373 @@ void ScanRead256PtrUnrollLoop(char* memarea, size_t size, size_t repeats)
 
 REGISTER(ScanRead256PtrUnrollLoop, 32, 32, 16);
 
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Pair and Non-Temporal Pair Operations
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// 128-bit writer with 64-bit pair stores, stp or non-temporal stnp, in an
+// unrolled loop (Assembler version)
+template <bool NT>
+void ScanWrite128PairPtrUnrollLoop(char* memarea, size_t size, size_t repeats)
+{
+    uint64_t value = 0xFAEE00C0FFEEEEEE;
+
+    asm volatile(
+        "mov    x4, %[value] \n"         // x4,x5 = 128-bit value
+        "mov    x5, %[value] \n"
+        "1: \n" // start of repeat loop
+        "mov    x16, %[memarea] \n"      // x16 = reset loop iterator
+        "2: \n" // start of write loop
+        ".irp   i, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 \n"
+        ".if    %c[nt] \n"
+        "stnp   x4, x5, [x16, #\\i*16] \n"
+        ".else \n"
+        "stp    x4, x5, [x16, #\\i*16] \n"
+        ".endif \n"
+        ".endr \n"
+        "add    x16, x16, #16*16 \n"
+        // test write loop condition
+        "cmp    x16, %[end] \n"          // compare to end iterator
+        "blo    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [value] "r" (value), [memarea] "r" (memarea), [end] "r" (memarea+size),
+          [nt] "i" (NT)
+        : "x4", "x5", "x16", "cc", "memory");
+}
+
+REGISTER_NAMED(ScanWrite128PairPtrUnrollLoop, ScanWrite128PairPtrUnrollLoop<false>, NULL, 16, 16, 16);
+REGISTER_NAMED(ScanWriteNT128PairPtrUnrollLoop, ScanWrite128PairPtrUnrollLoop<true>, NULL, 16, 16, 16);
+
+// 128-bit reader with 64-bit pair loads, ldp or non-temporal ldnp, in an
+// unrolled loop (Assembler version)
+template <bool NT>
+void ScanRead128PairPtrUnrollLoop(char* memarea, size_t size, size_t repeats)
+{
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    x16, %[memarea] \n"      // x16 = reset loop iterator
+        "2: \n" // start of read loop
+        ".irp   i, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 \n"
+        ".if    %c[nt] \n"
+        "ldnp   x4, x5, [x16, #\\i*16] \n"
+        ".else \n"
+        "ldp    x4, x5, [x16, #\\i*16] \n"
+        ".endif \n"
+        ".endr \n"
+        "add    x16, x16, #16*16 \n"
+        // test read loop condition
+        "cmp    x16, %[end] \n"          // compare to end iterator
+        "blo    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [end] "r" (memarea+size), [nt] "i" (NT)
+        : "x4", "x5", "x16", "cc", "memory");
+}
+
+REGISTER_NAMED(ScanRead128PairPtrUnrollLoop, ScanRead128PairPtrUnrollLoop<false>, NULL, 16, 16, 16);
+REGISTER_NAMED(ScanReadNT128PairPtrUnrollLoop, ScanRead128PairPtrUnrollLoop<true>, NULL, 16, 16, 16);
+
+// 256-bit writer with 128-bit pair stores, stp or non-temporal stnp, in an
+// unrolled loop (Assembler version)
+template <bool NT>
+void ScanWrite256PairPtrUnrollLoop(char* memarea, size_t size, size_t repeats)
+{
+    uint64_t value = 0xFAEE00C0FFEEEEEE;
+
+    asm volatile(
+        "dup    v4.2d, %[value] \n"      // v4,v5 = 256-bit value
+        "dup    v5.2d, %[value] \n"
+        "1: \n" // start of repeat loop
+        "mov    x16, %[memarea] \n"      // x16 = reset loop iterator
+        "2: \n" // start of write loop
+        ".irp   i, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 \n"
+        ".if    %c[nt] \n"
+        "stnp   q4, q5, [x16, #\\i*32] \n"
+        ".else \n"
+        "stp    q4, q5, [x16, #\\i*32] \n"
+        ".endif \n"
+        ".endr \n"
+        "add    x16, x16, #16*32 \n"
+        // test write loop condition
+        "cmp    x16, %[end] \n"          // compare to end iterator
+        "blo    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [value] "r" (value), [memarea] "r" (memarea), [end] "r" (memarea+size),
+          [nt] "i" (NT)
+        : "x16", "v4", "v5", "cc", "memory");
+}
+
+REGISTER_NAMED(ScanWrite256PairPtrUnrollLoop, ScanWrite256PairPtrUnrollLoop<false>, NULL, 32, 32, 16);
+REGISTER_NAMED(ScanWriteNT256PairPtrUnrollLoop, ScanWrite256PairPtrUnrollLoop<true>, NULL, 32, 32, 16);
+
+// 256-bit reader with 128-bit pair loads, ldp or non-temporal ldnp, in an
+// unrolled loop (Assembler version)
+template <bool NT>
+void ScanRead256PairPtrUnrollLoop(char* memarea, size_t size, size_t repeats)
+{
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    x16, %[memarea] \n"      // x16 = reset loop iterator
+        "2: \n" // start of read loop
+        ".irp   i, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 \n"
+        ".if    %c[nt] \n"
+        "ldnp   q4, q5, [x16, #\\i*32] \n"
+        ".else \n"
+        "ldp    q4, q5, [x16, #\\i*32] \n"
+        ".endif \n"
+        ".endr \n"
+        "add    x16, x16, #16*32 \n"
+        // test read loop condition
+        "cmp    x16, %[end] \n"          // compare to end iterator
+        "blo    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [end] "r" (memarea+size), [nt] "i" (NT)
+        : "x16", "v4", "v5", "cc", "memory");
+}
+
+REGISTER_NAMED(ScanRead256PairPtrUnrollLoop, ScanRead256PairPtrUnrollLoop<false>, NULL, 32, 32, 16);
+REGISTER_NAMED(ScanReadNT256PairPtrUnrollLoop, ScanRead256PairPtrUnrollLoop<true>, NULL, 32, 32, 16);
+
+// 512-bit writer with two 128-bit pair stores, stp or non-temporal stnp, in an
+// unrolled loop (Assembler version)
+template <bool NT>
+void ScanWrite512PairPtrUnrollLoop(char* memarea, size_t size, size_t repeats)
+{
+    uint64_t value = 0xFAEE00C0FFEEEEEE;
+
+    asm volatile(
+        "dup    v4.2d, %[value] \n"      // v4-v7 = 512-bit value
+        "dup    v5.2d, %[value] \n"
+        "dup    v6.2d, %[value] \n"
+        "dup    v7.2d, %[value] \n"
+        "1: \n" // start of repeat loop
+        "mov    x16, %[memarea] \n"      // x16 = reset loop iterator
+        "2: \n" // start of write loop
+        ".irp   i, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 \n"
+        ".if    %c[nt] \n"
+        "stnp   q4, q5, [x16, #\\i*64] \n"
+        "stnp   q6, q7, [x16, #\\i*64+32] \n"
+        ".else \n"
+        "stp    q4, q5, [x16, #\\i*64] \n"
+        "stp    q6, q7, [x16, #\\i*64+32] \n"
+        ".endif \n"
+        ".endr \n"
+        "add    x16, x16, #16*64 \n"
+        // test write loop condition
+        "cmp    x16, %[end] \n"          // compare to end iterator
+        "blo    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [value] "r" (value), [memarea] "r" (memarea), [end] "r" (memarea+size),
+          [nt] "i" (NT)
+        : "x16", "v4", "v5", "v6", "v7", "cc", "memory");
+}
+
+REGISTER_NAMED(ScanWrite512PairPtrUnrollLoop, ScanWrite512PairPtrUnrollLoop<false>, NULL, 64, 64, 16);
+REGISTER_NAMED(ScanWriteNT512PairPtrUnrollLoop, ScanWrite512PairPtrUnrollLoop<true>, NULL, 64, 64, 16);
+
+// 512-bit reader with two 128-bit pair loads, ldp or non-temporal ldnp, in an
+// unrolled loop (Assembler version)
+template <bool NT>
+void ScanRead512PairPtrUnrollLoop(char* memarea, size_t size, size_t repeats)
+{
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    x16, %[memarea] \n"      // x16 = reset loop iterator
+        "2: \n" // start of read loop
+        ".irp   i, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 \n"
+        ".if    %c[nt] \n"
+        "ldnp   q4, q5, [x16, #\\i*64] \n"
+        "ldnp   q6, q7, [x16, #\\i*64+32] \n"
+        ".else \n"
+        "ldp    q4, q5, [x16, #\\i*64] \n"
+        "ldp    q6, q7, [x16, #\\i*64+32] \n"
+        ".endif \n"
+        ".endr \n"
+        "add    x16, x16, #16*64 \n"
+        // test read loop condition
+        "cmp    x16, %[end] \n"          // compare to end iterator
+        "blo    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [end] "r" (memarea+size), [nt] "i" (NT)
+        : "x16", "v4", "v5", "v6", "v7", "cc", "memory");
+}
+
+REGISTER_NAMED(ScanRead512PairPtrUnrollLoop, ScanRead512PairPtrUnrollLoop<false>, NULL, 64, 64, 16);
+REGISTER_NAMED(ScanReadNT512PairPtrUnrollLoop, ScanRead512PairPtrUnrollLoop<true>, NULL, 64, 64, 16);
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Software Prefetching
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// 256-bit reader with 128-bit pair loads, prefetching each cache line D bytes
+// ahead with prfm pldl1keep (into L1) or pldl2strm (into L2, streaming). The
+// prefetches reach up to D bytes beyond the area, which does not fault.
+// (Assembler version)
+template <int D, bool Strm>
+void ScanRead256PairPtrPldLoop(char* memarea, size_t size, size_t repeats)
+{
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    x16, %[memarea] \n"      // x16 = reset loop iterator
+        "2: \n" // start of read loop
+        ".irp   i, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 \n"
+        ".if    (\\i & 1) == 0 \n"      // one prefetch per 64 byte line
+        ".if    %c[strm] \n"
+        "prfm   pldl2strm, [x16, #%c[d] + \\i*32] \n"
+        ".else \n"
+        "prfm   pldl1keep, [x16, #%c[d] + \\i*32] \n"
+        ".endif \n"
+        ".endif \n"
+        "ldp    q4, q5, [x16, #\\i*32] \n"
+        ".endr \n"
+        "add    x16, x16, #16*32 \n"
+        // test read loop condition
+        "cmp    x16, %[end] \n"          // compare to end iterator
+        "blo    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [end] "r" (memarea+size),
+          [d] "i" (D), [strm] "i" (Strm)
+        : "x16", "v4", "v5", "cc", "memory");
+}
+
+REGISTER_NAMED(ScanRead256PairPtrPldL1Keep256BLoop, (ScanRead256PairPtrPldLoop<256,false>), NULL, 32, 32, 16);
+REGISTER_NAMED(ScanRead256PairPtrPldL1Keep1KLoop, (ScanRead256PairPtrPldLoop<1024,false>), NULL, 32, 32, 16);
+REGISTER_NAMED(ScanRead256PairPtrPldL1Keep4KLoop, (ScanRead256PairPtrPldLoop<4096,false>), NULL, 32, 32, 16);
+REGISTER_NAMED(ScanRead256PairPtrPldL2Strm256BLoop, (ScanRead256PairPtrPldLoop<256,true>), NULL, 32, 32, 16);
+REGISTER_NAMED(ScanRead256PairPtrPldL2Strm1KLoop, (ScanRead256PairPtrPldLoop<1024,true>), NULL, 32, 32, 16);
+REGISTER_NAMED(ScanRead256PairPtrPldL2Strm4KLoop, (ScanRead256PairPtrPldLoop<4096,true>), NULL, 32, 32, 16);
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Zeroing
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// return the block size zeroed by DC ZVA: DCZID_EL0.BS is the log2 of the
+// number of 4-byte words per block
+static inline size_t dczva_blocksize()
+{
+    uint64_t dczid;
+    asm volatile("mrs %0, dczid_el0" : "=r" (dczid));
+    return (size_t)4 << (dczid & 0xF);
+}
+
+// record the DC ZVA block size
+void prepareScanZeroDcZvaLoop(int thread_num, char*, size_t)
+{
+    result_param(thread_num, "zvablock", dczva_blocksize());
+}
+
+// zero the area with DC ZVA, one block per instruction. The area is not
+// necessarily block aligned, partial blocks at its ends are cleared with
+// memset. All zeroing kernels count 64-byte lines as accesses.
+// (Assembler version)
+void ScanZeroDcZvaLoop(char* memarea, size_t size, size_t repeats)
+{
+    size_t block = dczva_blocksize();
+
+    char* begin = (char*)(((uintptr_t)memarea + block - 1) & ~(uintptr_t)(block - 1));
+    char* end = (char*)((uintptr_t)(memarea + size) & ~(uintptr_t)(block - 1));
+
+    if (end < begin) begin = end = memarea; // area within one block
+
+    do {
+        memset(memarea, 0, begin - memarea);
+
+        asm volatile(
+            "mov    x16, %[begin] \n"        // x16 = reset loop iterator
+            "b      3f \n"
+            "2: \n" // start of zero loop
+            "dc     zva, x16 \n"             // zero block
+            "add    x16, x16, %[block] \n"
+            "3: \n"
+            // test zero loop condition
+            "cmp    x16, %[end] \n"          // compare to end iterator
+            "blo    2b \n"
+            :
+            : [begin] "r" (begin), [end] "r" (end), [block] "r" (block)
+            : "x16", "cc", "memory");
+
+        memset(end, 0, memarea + size - end);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_PREPARE(ScanZeroDcZvaLoop, prepareScanZeroDcZvaLoop, "dczva", 64, 64, 32);
+
+// zero the area with 128-bit pair stores of the zero register (Assembler version)
+void ScanZeroStpLoop(char* memarea, size_t size, size_t repeats)
+{
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    x16, %[memarea] \n"      // x16 = reset loop iterator
+        "2: \n" // start of zero loop
+        ".irp   i, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 \n"
+        "stp    xzr, xzr, [x16, #\\i*16] \n"
+        ".endr \n"
+        "add    x16, x16, #16*16 \n"
+        // test zero loop condition
+        "cmp    x16, %[end] \n"          // compare to end iterator
+        "blo    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [end] "r" (memarea+size)
+        : "x16", "cc", "memory");
+}
+
+REGISTER(ScanZeroStpLoop, 64, 64, 32);
+
+// zero the area with non-temporal 128-bit pair stores of the zero register
+// (Assembler version)
+void ScanZeroStnpLoop(char* memarea, size_t size, size_t repeats)
+{
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    x16, %[memarea] \n"      // x16 = reset loop iterator
+        "2: \n" // start of zero loop
+        ".irp   i, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 \n"
+        "stnp   xzr, xzr, [x16, #\\i*16] \n"
+        ".endr \n"
+        "add    x16, x16, #16*16 \n"
+        // test zero loop condition
+        "cmp    x16, %[end] \n"          // compare to end iterator
+        "blo    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [end] "r" (memarea+size)
+        : "x16", "cc", "memory");
+}
+
+REGISTER(ScanZeroStnpLoop, 64, 64, 32);
+
 // ****************************************************************************
 // ----------------------------------------------------------------------------
 // Permutation Walking
@@ -633,4 +1000,490 @@ void PermRead64UnrollLoop(char* memarea, size_t, size_t repeats)
 
 REGISTER_PERM(PermRead64UnrollLoop, 8);
 
+// follow 64-bit permutation of one pointer per page: probes the TLB reach
+REGISTER_PERM_LAYOUT(PermPageRead64SimpleLoop, PermRead64SimpleLoop, 8, PERM_PAGE);
+
+// follow 64-bit cycle over all cache lines: pages in random order with their
+// lines in order, or pages in order with their lines in random order. Compared
+// to the fully random cycle this separates TLB walk from cache miss cost.
+REGISTER_PERM_LAYOUT(PermPageRandLineSeqRead64SimpleLoop, PermRead64SimpleLoop, 8, PERM_PAGE_RANDOM);
+REGISTER_PERM_LAYOUT(PermPageSeqLineRandRead64SimpleLoop, PermRead64SimpleLoop, 8, PERM_LINE_RANDOM);
+
+// walk permutation of blocks, reading each block with 128-bit pair loads (Assembler version)
+template <int B>
+void PermBlockRead128Loop(char* memarea, size_t, size_t repeats)
+{
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    x16, %[memarea] \n"      // x16 = reset iterator
+        "2: \n" // start of block loop
+        "ldr    x15, [x16] \n"           // x15 = next block in permutation
+        "add    x17, x16, %[b] \n"       // x17 = end of block
+        "3: \n" // start of read loop
+        "ldp    q4, q5, [x16], #32 \n"   // retrieve and advance 32
+        "ldp    q4, q5, [x16], #32 \n"
+        // test read loop condition
+        "cmp    x16, x17 \n"             // compare to end of block
+        "blo    3b \n"
+        "mov    x16, x15 \n"             // advance to next block
+        // test block loop condition
+        "cmp    x16, %[memarea] \n"      // compare to first iterator
+        "bne    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [b] "r" ((size_t)B)
+        : "x15", "x16", "x17", "v4", "v5", "cc", "memory");
+}
+
+REGISTER_PERM_BLOCK(PermBlock64BRead128Loop, PermBlockRead128Loop<64>, NULL, 64);
+REGISTER_PERM_BLOCK(PermBlock256BRead128Loop, PermBlockRead128Loop<256>, NULL, 256);
+REGISTER_PERM_BLOCK(PermBlock1KRead128Loop, PermBlockRead128Loop<1024>, NULL, 1024);
+REGISTER_PERM_BLOCK(PermBlock4KRead128Loop, PermBlockRead128Loop<4096>, NULL, 4096);
+REGISTER_PERM_BLOCK(PermBlock16KRead128Loop, PermBlockRead128Loop<16384>, NULL, 16384);
+REGISTER_PERM_BLOCK(PermBlock64KRead128Loop, PermBlockRead128Loop<65536>, NULL, 65536);
+REGISTER_PERM_BLOCK(PermBlock256KRead128Loop, PermBlockRead128Loop<262144>, NULL, 262144);
+REGISTER_PERM_BLOCK(PermBlock1MRead128Loop, PermBlockRead128Loop<1048576>, NULL, 1048576);
+
+// walk linked list of nodes of N bytes, reading K payload words spread evenly
+// over each node besides the next pointer (Assembler version)
+template <int N, int K>
+void ListNodeRead64Loop(char* memarea, size_t, size_t repeats)
+{
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    x16, %[memarea] \n"      // x16 = reset iterator
+        "2: \n" // start of node loop
+        ".set   .Lpayload, %c[step] \n"
+        ".rept  %c[k] \n"                // read payload words
+        "ldr    x15, [x16, #.Lpayload] \n"
+        ".set   .Lpayload, .Lpayload + %c[step] \n"
+        ".endr \n"
+        "ldr    x16, [x16] \n"           // x16 = next node
+        // test node loop condition
+        "cmp    x16, %[memarea] \n"      // compare to first iterator
+        "bne    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [k] "i" (K), [step] "i" ((N / (K+1)) & ~7)
+        : "x15", "x16", "cc", "memory");
+}
+
+REGISTER_PERM_NODE(List32BNodeRead0x64Loop, (ListNodeRead64Loop<32,0>), NULL, 8, 32);
+REGISTER_PERM_NODE(List32BNodeRead1x64Loop, (ListNodeRead64Loop<32,1>), NULL, 16, 32);
+REGISTER_PERM_NODE(List32BNodeRead2x64Loop, (ListNodeRead64Loop<32,2>), NULL, 24, 32);
+REGISTER_PERM_NODE(List32BNodeRead3x64Loop, (ListNodeRead64Loop<32,3>), NULL, 32, 32);
+REGISTER_PERM_NODE(List64BNodeRead0x64Loop, (ListNodeRead64Loop<64,0>), NULL, 8, 64);
+REGISTER_PERM_NODE(List64BNodeRead1x64Loop, (ListNodeRead64Loop<64,1>), NULL, 16, 64);
+REGISTER_PERM_NODE(List64BNodeRead2x64Loop, (ListNodeRead64Loop<64,2>), NULL, 24, 64);
+REGISTER_PERM_NODE(List64BNodeRead7x64Loop, (ListNodeRead64Loop<64,7>), NULL, 64, 64);
+REGISTER_PERM_NODE(List128BNodeRead0x64Loop, (ListNodeRead64Loop<128,0>), NULL, 8, 128);
+REGISTER_PERM_NODE(List128BNodeRead1x64Loop, (ListNodeRead64Loop<128,1>), NULL, 16, 128);
+REGISTER_PERM_NODE(List128BNodeRead4x64Loop, (ListNodeRead64Loop<128,4>), NULL, 40, 128);
+REGISTER_PERM_NODE(List128BNodeRead15x64Loop, (ListNodeRead64Loop<128,15>), NULL, 128, 128);
+REGISTER_PERM_NODE(List256BNodeRead0x64Loop, (ListNodeRead64Loop<256,0>), NULL, 8, 256);
+REGISTER_PERM_NODE(List256BNodeRead1x64Loop, (ListNodeRead64Loop<256,1>), NULL, 16, 256);
+REGISTER_PERM_NODE(List256BNodeRead8x64Loop, (ListNodeRead64Loop<256,8>), NULL, 72, 256);
+REGISTER_PERM_NODE(List256BNodeRead31x64Loop, (ListNodeRead64Loop<256,31>), NULL, 256, 256);
+REGISTER_PERM_NODE(List512BNodeRead0x64Loop, (ListNodeRead64Loop<512,0>), NULL, 8, 512);
+REGISTER_PERM_NODE(List512BNodeRead1x64Loop, (ListNodeRead64Loop<512,1>), NULL, 16, 512);
+REGISTER_PERM_NODE(List512BNodeRead16x64Loop, (ListNodeRead64Loop<512,16>), NULL, 136, 512);
+REGISTER_PERM_NODE(List512BNodeRead63x64Loop, (ListNodeRead64Loop<512,63>), NULL, 512, 512);
+
+// follow Chains independent 64-bit cycles at once, interleaved over the whole
+// area, to measure memory-level parallelism. The chains are kept in
+// registers x0-x15, all return to their first pointer together. (Assembler version)
+template <int Chains>
+void PermRead64ChainsLoop(char* memarea, size_t, size_t repeats)
+{
+    asm volatile(
+        "mov    x16, %[memarea] \n"      // x16 = first pointer of chain
+        ".irp   r, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 \n"
+        ".if    \\r < %c[chains] \n"
+        "mov    x\\r, x16 \n"
+        "add    x16, x16, %[stride] \n"  // advance to next chain
+        ".endif \n"
+        ".endr \n"
+        "1: \n" // start of repeat loop
+        "2: \n" // start of loop
+        ".irp   r, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 \n"
+        ".if    \\r < %c[chains] \n"
+        "ldr    x\\r, [x\\r] \n"
+        ".endif \n"
+        ".endr \n"
+        // test loop condition
+        "cmp    x0, %[memarea] \n"       // compare to first iterator
+        "bne    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [stride] "r" (g_perm_stride), [chains] "i" (Chains)
+        : "x0", "x1", "x2", "x3", "x4", "x5", "x6", "x7", "x8", "x9", "x10",
+          "x11", "x12", "x13", "x14", "x15", "x16", "cc", "memory");
+}
+
+REGISTER_PERM_CHAINS(PermRead64Chains2Loop, PermRead64ChainsLoop<2>, NULL, 8, 2);
+REGISTER_PERM_CHAINS(PermRead64Chains4Loop, PermRead64ChainsLoop<4>, NULL, 8, 4);
+REGISTER_PERM_CHAINS(PermRead64Chains8Loop, PermRead64ChainsLoop<8>, NULL, 8, 8);
+REGISTER_PERM_CHAINS(PermRead64Chains16Loop, PermRead64ChainsLoop<16>, NULL, 8, 16);
+
+// follow Chains independent 64-bit cycles at once, for more chains than free
+// registers: the chains are kept in an array on the stack, which adds an L1
+// load and store to each step. (Assembler version)
+template <int Chains>
+void PermRead64ChainsStackLoop(char* memarea, size_t, size_t repeats)
+{
+    char* chain[Chains];
+
+    for (int c = 0; c < Chains; ++c)
+        chain[c] = memarea + c * g_perm_stride;
+
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "2: \n" // start of loop
+        ".set   .Lchain, 0 \n"
+        ".rept  %c[chains] \n"
+        "ldr    x16, [%[chain], #.Lchain] \n"
+        "ldr    x16, [x16] \n"
+        "str    x16, [%[chain], #.Lchain] \n"
+        ".set   .Lchain, .Lchain + 8 \n"
+        ".endr \n"
+        // test loop condition
+        "ldr    x16, [%[chain]] \n"
+        "cmp    x16, %[memarea] \n"      // compare to first iterator
+        "bne    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [chain] "r" (chain), [chains] "i" (Chains)
+        : "x16", "cc", "memory");
+}
+
+REGISTER_PERM_CHAINS(PermRead64Chains32Loop, PermRead64ChainsStackLoop<32>, NULL, 8, 32);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Instruction Fetching
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// fill the area with straight-line NOPs followed by a RET
+void prepareScanExec32NopLoop(int, char* memarea, size_t size)
+{
+    uint32_t* begin = (uint32_t*)memarea;
+    uint32_t* end = begin + size / sizeof(uint32_t) - 1;
+
+    for (uint32_t* p = begin; p < end; ++p)
+        *p = 0xD503201F;                // nop
+
+    *end = 0xD65F03C0;                  // ret
+
+    clear_icache(memarea, size);
+}
+
+// call the generated straight-line code (Assembler version)
+void ScanExec32NopLoop(char* memarea, size_t, size_t repeats)
+{
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "blr    %[memarea] \n"          // run through the code area
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea)
+        : "x30", "cc", "memory");
+}
+
+REGISTER_EXEC(ScanExec32NopLoop, prepareScanExec32NopLoop, NULL, 4);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Memory Barriers
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// barrier instruction issued by ScanWrite128PtrBarrierLoop after every K stores
+enum { BARRIER_NONE, BARRIER_DMB_ISHST, BARRIER_DMB_ISH, BARRIER_DSB_ISH };
+
+// 128-bit (non-temporal) pair writer with a barrier after every K stores
+// (Assembler version)
+template <bool NT, int Barrier, int K>
+void ScanWrite128PtrBarrierLoop(char* memarea, size_t size, size_t repeats)
+{
+    uint64_t value = 0xFAEE00C0FFEEEEEE;
+
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    x16, %[memarea] \n"      // x16 = reset loop iterator
+        "2: \n" // start of write loop
+        ".rept  %c[k] \n"                // K stores
+        ".if    %c[nt] \n"
+        "stnp   %[value], %[value], [x16] \n"
+        ".else \n"
+        "stp    %[value], %[value], [x16] \n"
+        ".endif \n"
+        "add    x16, x16, #16 \n"
+        ".endr \n"
+        ".if    %c[barrier] == 1 \n"
+        "dmb    ishst \n"
+        ".elseif %c[barrier] == 2 \n"
+        "dmb    ish \n"
+        ".elseif %c[barrier] == 3 \n"
+        "dsb    ish \n"
+        ".endif \n"
+        // test write loop condition
+        "cmp    x16, %[end] \n"          // compare to end iterator
+        "blo    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [value] "r" (value), [memarea] "r" (memarea), [end] "r" (memarea+size),
+          [nt] "i" (NT), [barrier] "i" (Barrier), [k] "i" (K)
+        : "x16", "cc", "memory");
+}
+
+REGISTER_FENCE(ScanWrite128PtrDmbIshst1Loop, (ScanWrite128PtrBarrierLoop<false, BARRIER_DMB_ISHST, 1>),
+               (ScanWrite128PtrBarrierLoop<false, BARRIER_NONE, 1>), NULL, 16, 1);
+REGISTER_FENCE(ScanWrite128PtrDmbIshst4Loop, (ScanWrite128PtrBarrierLoop<false, BARRIER_DMB_ISHST, 4>),
+               (ScanWrite128PtrBarrierLoop<false, BARRIER_NONE, 4>), NULL, 16, 4);
+REGISTER_FENCE(ScanWrite128PtrDmbIshst16Loop, (ScanWrite128PtrBarrierLoop<false, BARRIER_DMB_ISHST, 16>),
+               (ScanWrite128PtrBarrierLoop<false, BARRIER_NONE, 16>), NULL, 16, 16);
+REGISTER_FENCE(ScanWrite128PtrDmbIshst64Loop, (ScanWrite128PtrBarrierLoop<false, BARRIER_DMB_ISHST, 64>),
+               (ScanWrite128PtrBarrierLoop<false, BARRIER_NONE, 64>), NULL, 16, 64);
+
+REGISTER_FENCE(ScanWrite128PtrDmbIsh1Loop, (ScanWrite128PtrBarrierLoop<false, BARRIER_DMB_ISH, 1>),
+               (ScanWrite128PtrBarrierLoop<false, BARRIER_NONE, 1>), NULL, 16, 1);
+REGISTER_FENCE(ScanWrite128PtrDmbIsh4Loop, (ScanWrite128PtrBarrierLoop<false, BARRIER_DMB_ISH, 4>),
+               (ScanWrite128PtrBarrierLoop<false, BARRIER_NONE, 4>), NULL, 16, 4);
+REGISTER_FENCE(ScanWrite128PtrDmbIsh16Loop, (ScanWrite128PtrBarrierLoop<false, BARRIER_DMB_ISH, 16>),
+               (ScanWrite128PtrBarrierLoop<false, BARRIER_NONE, 16>), NULL, 16, 16);
+REGISTER_FENCE(ScanWrite128PtrDmbIsh64Loop, (ScanWrite128PtrBarrierLoop<false, BARRIER_DMB_ISH, 64>),
+               (ScanWrite128PtrBarrierLoop<false, BARRIER_NONE, 64>), NULL, 16, 64);
+
+REGISTER_FENCE(ScanWrite128PtrDsbIsh1Loop, (ScanWrite128PtrBarrierLoop<false, BARRIER_DSB_ISH, 1>),
+               (ScanWrite128PtrBarrierLoop<false, BARRIER_NONE, 1>), NULL, 16, 1);
+REGISTER_FENCE(ScanWrite128PtrDsbIsh4Loop, (ScanWrite128PtrBarrierLoop<false, BARRIER_DSB_ISH, 4>),
+               (ScanWrite128PtrBarrierLoop<false, BARRIER_NONE, 4>), NULL, 16, 4);
+REGISTER_FENCE(ScanWrite128PtrDsbIsh16Loop, (ScanWrite128PtrBarrierLoop<false, BARRIER_DSB_ISH, 16>),
+               (ScanWrite128PtrBarrierLoop<false, BARRIER_NONE, 16>), NULL, 16, 16);
+REGISTER_FENCE(ScanWrite128PtrDsbIsh64Loop, (ScanWrite128PtrBarrierLoop<false, BARRIER_DSB_ISH, 64>),
+               (ScanWrite128PtrBarrierLoop<false, BARRIER_NONE, 64>), NULL, 16, 64);
+
+REGISTER_FENCE(ScanWriteNT128PtrDmbIshst1Loop, (ScanWrite128PtrBarrierLoop<true, BARRIER_DMB_ISHST, 1>),
+               (ScanWrite128PtrBarrierLoop<true, BARRIER_NONE, 1>), NULL, 16, 1);
+REGISTER_FENCE(ScanWriteNT128PtrDmbIshst4Loop, (ScanWrite128PtrBarrierLoop<true, BARRIER_DMB_ISHST, 4>),
+               (ScanWrite128PtrBarrierLoop<true, BARRIER_NONE, 4>), NULL, 16, 4);
+REGISTER_FENCE(ScanWriteNT128PtrDmbIshst16Loop, (ScanWrite128PtrBarrierLoop<true, BARRIER_DMB_ISHST, 16>),
+               (ScanWrite128PtrBarrierLoop<true, BARRIER_NONE, 16>), NULL, 16, 16);
+REGISTER_FENCE(ScanWriteNT128PtrDmbIshst64Loop, (ScanWrite128PtrBarrierLoop<true, BARRIER_DMB_ISHST, 64>),
+               (ScanWrite128PtrBarrierLoop<true, BARRIER_NONE, 64>), NULL, 16, 64);
+
+REGISTER_FENCE(ScanWriteNT128PtrDmbIsh1Loop, (ScanWrite128PtrBarrierLoop<true, BARRIER_DMB_ISH, 1>),
+               (ScanWrite128PtrBarrierLoop<true, BARRIER_NONE, 1>), NULL, 16, 1);
+REGISTER_FENCE(ScanWriteNT128PtrDmbIsh4Loop, (ScanWrite128PtrBarrierLoop<true, BARRIER_DMB_ISH, 4>),
+               (ScanWrite128PtrBarrierLoop<true, BARRIER_NONE, 4>), NULL, 16, 4);
+REGISTER_FENCE(ScanWriteNT128PtrDmbIsh16Loop, (ScanWrite128PtrBarrierLoop<true, BARRIER_DMB_ISH, 16>),
+               (ScanWrite128PtrBarrierLoop<true, BARRIER_NONE, 16>), NULL, 16, 16);
+REGISTER_FENCE(ScanWriteNT128PtrDmbIsh64Loop, (ScanWrite128PtrBarrierLoop<true, BARRIER_DMB_ISH, 64>),
+               (ScanWrite128PtrBarrierLoop<true, BARRIER_NONE, 64>), NULL, 16, 64);
+
+REGISTER_FENCE(ScanWriteNT128PtrDsbIsh1Loop, (ScanWrite128PtrBarrierLoop<true, BARRIER_DSB_ISH, 1>),
+               (ScanWrite128PtrBarrierLoop<true, BARRIER_NONE, 1>), NULL, 16, 1);
+REGISTER_FENCE(ScanWriteNT128PtrDsbIsh4Loop, (ScanWrite128PtrBarrierLoop<true, BARRIER_DSB_ISH, 4>),
+               (ScanWrite128PtrBarrierLoop<true, BARRIER_NONE, 4>), NULL, 16, 4);
+REGISTER_FENCE(ScanWriteNT128PtrDsbIsh16Loop, (ScanWrite128PtrBarrierLoop<true, BARRIER_DSB_ISH, 16>),
+               (ScanWrite128PtrBarrierLoop<true, BARRIER_NONE, 16>), NULL, 16, 16);
+REGISTER_FENCE(ScanWriteNT128PtrDsbIsh64Loop, (ScanWrite128PtrBarrierLoop<true, BARRIER_DSB_ISH, 64>),
+               (ScanWrite128PtrBarrierLoop<true, BARRIER_NONE, 64>), NULL, 16, 64);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Random Pointer Streams: Zipf Distributed and Reuse Distance Driven Access
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// 64-bit reader of a prepared pointer stream (Assembler version)
+void StreamRead64PtrSimpleLoop(char*, size_t size, size_t repeats)
+{
+    char** stream = (char**)t_auxarea;
+
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    x16, %[stream] \n"       // x16 = reset stream iterator
+        "2: \n" // start of read loop
+        "ldr    x17, [x16], #8 \n"       // x17 = next pointer in stream
+        "ldr    x0, [x17] \n"
+        // test read loop condition
+        "cmp    x16, %[end] \n"          // compare to end iterator
+        "blo    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [stream] "r" (stream), [end] "r" (stream + size / 64)
+        : "x0", "x16", "x17", "cc", "memory");
+}
+
+// 64-bit reader of a prepared pointer stream, where each read depends on the
+// previous one (Assembler version)
+void StreamRead64PtrDependLoop(char*, size_t size, size_t repeats)
+{
+    char** stream = (char**)t_auxarea;
+
+    asm volatile(
+        "mov    x0, #0 \n"               // x0 = zero
+        "1: \n" // start of repeat loop
+        "mov    x16, %[stream] \n"       // x16 = reset stream iterator
+        "2: \n" // start of read loop
+        "ldr    x17, [x16], #8 \n"       // x17 = next pointer in stream
+        "add    x17, x17, x0 \n"         // add zero from previous read
+        "ldr    x0, [x17] \n"
+        "and    x0, x0, xzr \n"          // zero, but depending on the read
+        // test read loop condition
+        "cmp    x16, %[end] \n"          // compare to end iterator
+        "blo    2b \n"
+        // test repeat loop condition
+        "subs   %[repeats], %[repeats], #1 \n" // until repeats = 0
+        "bne    1b \n"
+        : [repeats] "+r" (repeats)
+        : [stream] "r" (stream), [end] "r" (stream + size / 64)
+        : "x0", "x16", "x17", "cc", "memory");
+}
+
+// read Zipf distributed pointer streams
+REGISTER_PREPARE_NAMED(ZipfRead64PtrSimpleLoop, StreamRead64PtrSimpleLoop, prepare_zipf_stream, NULL, 8, 64, 1);
+REGISTER_PREPARE_NAMED(ZipfRead64PtrDependLoop, StreamRead64PtrDependLoop, prepare_zipf_stream, NULL, 8, 64, 1);
+
+// read pointer streams with reuse distance histogram given by -D
+REGISTER_PREPARE_NAMED(ReuseRead64PtrSimpleLoop, StreamRead64PtrSimpleLoop, prepare_reuse_stream, NULL, 8, 64, 1);
+REGISTER_PREPARE_NAMED(ReuseRead64PtrDependLoop, StreamRead64PtrDependLoop, prepare_reuse_stream, NULL, 8, 64, 1);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// CRC32C Checksums: checksum the area with the crc32cx instruction of the
+// CRC32 extension in one to three interleaved chains over consecutive
+// segments, which hide the instruction's latency, and combine the chains'
+// CRCs.
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// continue the CRC over [begin,end) in a single chain
+static inline uint32_t crc32c_chain1(const char* begin, const char* end, uint32_t crc)
+{
+    asm volatile(
+        ".arch_extension crc \n"
+        "b      2f \n"
+        "1: \n" // start of checksum loop
+        "ldr    x16, [%[p]], #8 \n"      // retrieve and advance 8
+        "crc32cx %w[crc], %w[crc], x16 \n"
+        "2: \n"
+        // test checksum loop condition
+        "cmp    %[p], %[end] \n"         // compare to end iterator
+        "blo    1b \n"
+        : [crc] "+r" (crc), [p] "+r" (begin)
+        : [end] "r" (end)
+        : "x16", "cc", "memory");
+    return crc;
+}
+
+// checksum in one chain (Assembler version)
+void Crc32c64Loop(char* memarea, size_t size, size_t repeats)
+{
+    do {
+        uint32_t crc = crc32c_chain1(memarea, memarea + size, 0xFFFFFFFF);
+        keep_value(crc ^ 0xFFFFFFFF);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_CPUFEAT(Crc32c64Loop, "crc32", 8, 8, 16);
+
+// checksum two halves in interleaved chains (Assembler version)
+void Crc32c64Way2Loop(char* memarea, size_t size, size_t repeats)
+{
+    size_t seg = size / 16 * 8;
+    uint32_t shift = crc32c_shift_factor(size - seg);
+
+    do {
+        uint32_t c0 = 0xFFFFFFFF, c1 = 0;
+        const char* p = memarea;
+
+        asm volatile(
+            ".arch_extension crc \n"
+            "1: \n" // start of checksum loop
+            "ldr    x15, [%[p]] \n"
+            "ldr    x16, [%[p], %[seg]] \n"
+            "add    %[p], %[p], #8 \n"
+            "crc32cx %w[c0], %w[c0], x15 \n"
+            "crc32cx %w[c1], %w[c1], x16 \n"
+            // test checksum loop condition
+            "cmp    %[p], %[end] \n"     // compare to end of first segment
+            "blo    1b \n"
+            : [c0] "+r" (c0), [c1] "+r" (c1), [p] "+r" (p)
+            : [seg] "r" (seg), [end] "r" (memarea + seg)
+            : "x15", "x16", "cc", "memory");
+
+        c1 = crc32c_chain1(memarea + 2 * seg, memarea + size, c1);
+
+        uint32_t crc = crc32c_multiply(c0, shift) ^ c1;
+        keep_value(crc ^ 0xFFFFFFFF);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_CPUFEAT(Crc32c64Way2Loop, "crc32", 8, 8, 16);
+
+// checksum three thirds in interleaved chains (Assembler version)
+void Crc32c64Way3Loop(char* memarea, size_t size, size_t repeats)
+{
+    size_t seg = size / 24 * 8;
+    uint32_t shift1 = crc32c_shift_factor(seg);
+    uint32_t shift2 = crc32c_shift_factor(size - 2 * seg);
+
+    do {
+        uint32_t c0 = 0xFFFFFFFF, c1 = 0, c2 = 0;
+        const char* p = memarea;
+
+        asm volatile(
+            ".arch_extension crc \n"
+            "1: \n" // start of checksum loop
+            "ldr    x15, [%[p]] \n"
+            "ldr    x16, [%[p], %[seg]] \n"
+            "ldr    x17, [%[p], %[seg2]] \n"
+            "add    %[p], %[p], #8 \n"
+            "crc32cx %w[c0], %w[c0], x15 \n"
+            "crc32cx %w[c1], %w[c1], x16 \n"
+            "crc32cx %w[c2], %w[c2], x17 \n"
+            // test checksum loop condition
+            "cmp    %[p], %[end] \n"     // compare to end of first segment
+            "blo    1b \n"
+            : [c0] "+r" (c0), [c1] "+r" (c1), [c2] "+r" (c2), [p] "+r" (p)
+            : [seg] "r" (seg), [seg2] "r" (2 * seg), [end] "r" (memarea + seg)
+            : "x15", "x16", "x17", "cc", "memory");
+
+        c2 = crc32c_chain1(memarea + 3 * seg, memarea + size, c2);
+
+        uint32_t crc = crc32c_multiply(crc32c_multiply(c0, shift1) ^ c1, shift2) ^ c2;
+        keep_value(crc ^ 0xFFFFFFFF);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_CPUFEAT(Crc32c64Way3Loop, "crc32", 8, 8, 16);
+
 // -----------------------------------------------------------------------------
@@ -169,6 +169,15 @@ void cPermRead32SimpleLoop(char* memarea, size_t, size_t repeats)
 
 REGISTER_PERM(cPermRead32SimpleLoop, 4);
 
+// follow 32-bit permutation of one pointer per page: probes the TLB reach
+REGISTER_PERM_LAYOUT(cPermPageRead32SimpleLoop, cPermRead32SimpleLoop, 4, PERM_PAGE);
+
+// follow 32-bit cycle over all cache lines: pages in random order with their
+// lines in order, or pages in order with their lines in random order. Compared
+// to the fully random cycle this separates TLB walk from cache miss cost.
+REGISTER_PERM_LAYOUT(cPermPageRandLineSeqRead32SimpleLoop, cPermRead32SimpleLoop, 4, PERM_PAGE_RANDOM);
+REGISTER_PERM_LAYOUT(cPermPageSeqLineRandRead32SimpleLoop, cPermRead32SimpleLoop, 4, PERM_LINE_RANDOM);
+
 #else
 
 // follow 64-bit permutation in a simple loop (C version)
@@ -188,6 +197,15 @@ void cPermRead64SimpleLoop(char* memarea, size_t, size_t repeats)
 
 REGISTER_PERM(cPermRead64SimpleLoop, 8);
 
+// follow 64-bit permutation of one pointer per page: probes the TLB reach
+REGISTER_PERM_LAYOUT(cPermPageRead64SimpleLoop, cPermRead64SimpleLoop, 8, PERM_PAGE);
+
+// follow 64-bit cycle over all cache lines: pages in random order with their
+// lines in order, or pages in order with their lines in random order. Compared
+// to the fully random cycle this separates TLB walk from cache miss cost.
+REGISTER_PERM_LAYOUT(cPermPageRandLineSeqRead64SimpleLoop, cPermRead64SimpleLoop, 8, PERM_PAGE_RANDOM);
+REGISTER_PERM_LAYOUT(cPermPageSeqLineRandRead64SimpleLoop, cPermRead64SimpleLoop, 8, PERM_LINE_RANDOM);
+
 #endif
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * funcs_libc.h
+ *
+ * Wrappers of the C and C++ library's memory routines, common to all
+ * architectures: they show whether the library reaches the bandwidth of the
+ * hand-written loops. Copies count the bytes read plus the bytes written.
+ *
+ ******************************************************************************
+ * Copyright (C) 2013 Timo Bingmann <tb@panthema.net>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+// keep the compiler from eliding or merging the calls of repeated loops,
+// which overwrite the same memory without reading it in between
+static inline void clobber_memory(char* memarea)
+{
+    asm volatile("" : : "r" (memarea) : "memory");
+}
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Filling and Copying
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// fill the area with memset()
+void LibcMemsetLoop(char* memarea, size_t size, size_t repeats)
+{
+    do {
+        memset(memarea, (int)repeats, size);
+        clobber_memory(memarea);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER(LibcMemsetLoop, 8, 8, 16);
+
+// copy the first half of the area to the second half with memcpy()
+void LibcMemcpyLoop(char* memarea, size_t size, size_t repeats)
+{
+    do {
+        memcpy(memarea + size / 2, memarea, size / 2);
+        clobber_memory(memarea);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER(LibcMemcpyLoop, 8, 8, 16);
+
+// copy the first half of the area to the second half with memmove()
+void LibcMemmoveLoop(char* memarea, size_t size, size_t repeats)
+{
+    do {
+        memmove(memarea + size / 2, memarea, size / 2);
+        clobber_memory(memarea);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER(LibcMemmoveLoop, 8, 8, 16);
+
+// move the first half of the area up by one cache line with memmove(), which
+// must copy backwards as source and destination overlap. Areas of less than
+// two cache lines move by half their size to stay within them.
+void LibcMemmoveOverlapLoop(char* memarea, size_t size, size_t repeats)
+{
+    size_t shift = std::min<size_t>(64, size / 2);
+
+    do {
+        memmove(memarea + shift, memarea, size / 2);
+        clobber_memory(memarea);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER(LibcMemmoveOverlapLoop, 8, 8, 16);
+
+// copy the first half of the area to the second half with std::copy() of
+// 64-bit values
+void StdCopy64Loop(char* memarea, size_t size, size_t repeats)
+{
+    const uint64_t* src = (const uint64_t*)memarea;
+    uint64_t* dst = (uint64_t*)(memarea + size / 2);
+    size_t n = size / 2 / sizeof(uint64_t);
+
+    do {
+        std::copy(src, src + n, dst);
+        clobber_memory(memarea);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER(StdCopy64Loop, 8, 8, 16);
+
+// -----------------------------------------------------------------------------
@@ -837,4 +837,51 @@ void PermRead32UnrollLoop(char* memarea, size_t, size_t repeats)
 
 REGISTER_PERM(PermRead32UnrollLoop, 4);
 
+// follow 32-bit permutation of one pointer per page: probes the TLB reach
+REGISTER_PERM_LAYOUT(PermPageRead32SimpleLoop, PermRead32SimpleLoop, 4, PERM_PAGE);
+
+// follow 32-bit cycle over all cache lines: pages in random order with their
+// lines in order, or pages in order with their lines in random order. Compared
+// to the fully random cycle this separates TLB walk from cache miss cost.
+REGISTER_PERM_LAYOUT(PermPageRandLineSeqRead32SimpleLoop, PermRead32SimpleLoop, 4, PERM_PAGE_RANDOM);
+REGISTER_PERM_LAYOUT(PermPageSeqLineRandRead32SimpleLoop, PermRead32SimpleLoop, 4, PERM_LINE_RANDOM);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Instruction Fetching
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// fill the area with straight-line 8-byte NOPs followed by a RET
+void prepareScanExec64NopLoop(int, char* memarea, size_t size)
+{
+    uint64_t* begin = (uint64_t*)memarea;
+    uint64_t* end = begin + size / sizeof(uint64_t) - 1;
+
+    for (uint64_t* p = begin; p < end; ++p)
+        *p = 0x0000000000841F0FLLU;     // nopl 0x0(%eax,%eax,1)
+
+    *end = 0xCCCCCCCCCCCCCCC3LLU;       // ret + int3 padding
+
+    clear_icache(memarea, size);
+}
+
+// call the generated straight-line code (Assembler version)
+void ScanExec64NopLoop(char* memarea, size_t, size_t repeats)
+{
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "call   *%[memarea] \n"         // run through the code area
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea)
+        : "cc", "memory");
+}
+
+REGISTER_EXEC(ScanExec64NopLoop, prepareScanExec64NopLoop, NULL, 8);
+
 // -----------------------------------------------------------------------------
@@ -857,4 +857,485 @@ void PermRead64UnrollLoop(char* memarea, size_t, size_t repeats)
 
 REGISTER_PERM(PermRead64UnrollLoop, 8);
 
+// follow 64-bit permutation of one pointer per page: probes the TLB reach
+REGISTER_PERM_LAYOUT(PermPageRead64SimpleLoop, PermRead64SimpleLoop, 8, PERM_PAGE);
+
+// follow 64-bit cycle over all cache lines: pages in random order with their
+// lines in order, or pages in order with their lines in random order. Compared
+// to the fully random cycle this separates TLB walk from cache miss cost.
+REGISTER_PERM_LAYOUT(PermPageRandLineSeqRead64SimpleLoop, PermRead64SimpleLoop, 8, PERM_PAGE_RANDOM);
+REGISTER_PERM_LAYOUT(PermPageSeqLineRandRead64SimpleLoop, PermRead64SimpleLoop, 8, PERM_LINE_RANDOM);
+
+// walk permutation of blocks, reading each block with 128-bit loads (Assembler version)
+template <int B>
+void PermBlockRead128Loop(char* memarea, size_t, size_t repeats)
+{
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    %[memarea], %%rax \n"   // rax = reset iterator
+        "2: \n" // start of block loop
+        "mov    (%%rax), %%rdx \n"      // rdx = next block in permutation
+        "lea    %c[b](%%rax), %%rcx \n" // rcx = end of block
+        "3: \n" // start of read loop
+        "movdqa 0*16(%%rax), %%xmm0 \n"
+        "movdqa 1*16(%%rax), %%xmm0 \n"
+        "movdqa 2*16(%%rax), %%xmm0 \n"
+        "movdqa 3*16(%%rax), %%xmm0 \n"
+        "add    $4*16, %%rax \n"
+        // test read loop condition
+        "cmp    %%rcx, %%rax \n"        // compare to end of block
+        "jb     3b \n"
+        "mov    %%rdx, %%rax \n"        // advance to next block
+        // test block loop condition
+        "cmp    %%rax, %[memarea] \n"   // compare to first iterator
+        "jne    2b \n"
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [b] "i" (B)
+        : "rax", "rcx", "rdx", "xmm0", "cc", "memory");
+}
+
+REGISTER_PERM_BLOCK(PermBlock64BRead128Loop, PermBlockRead128Loop<64>, "sse2", 64);
+REGISTER_PERM_BLOCK(PermBlock256BRead128Loop, PermBlockRead128Loop<256>, "sse2", 256);
+REGISTER_PERM_BLOCK(PermBlock1KRead128Loop, PermBlockRead128Loop<1024>, "sse2", 1024);
+REGISTER_PERM_BLOCK(PermBlock4KRead128Loop, PermBlockRead128Loop<4096>, "sse2", 4096);
+REGISTER_PERM_BLOCK(PermBlock16KRead128Loop, PermBlockRead128Loop<16384>, "sse2", 16384);
+REGISTER_PERM_BLOCK(PermBlock64KRead128Loop, PermBlockRead128Loop<65536>, "sse2", 65536);
+REGISTER_PERM_BLOCK(PermBlock256KRead128Loop, PermBlockRead128Loop<262144>, "sse2", 262144);
+REGISTER_PERM_BLOCK(PermBlock1MRead128Loop, PermBlockRead128Loop<1048576>, "sse2", 1048576);
+
+// walk linked list of nodes of N bytes, reading K payload words spread evenly
+// over each node besides the next pointer (Assembler version)
+template <int N, int K>
+void ListNodeRead64Loop(char* memarea, size_t, size_t repeats)
+{
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    %[memarea], %%rax \n"   // rax = reset iterator
+        "2: \n" // start of node loop
+        ".set   .Lpayload, %c[step] \n"
+        ".rept  %c[k] \n"               // read payload words
+        "mov    .Lpayload(%%rax), %%rcx \n"
+        ".set   .Lpayload, .Lpayload + %c[step] \n"
+        ".endr \n"
+        "mov    (%%rax), %%rax \n"      // rax = next node
+        // test node loop condition
+        "cmp    %%rax, %[memarea] \n"   // compare to first iterator
+        "jne    2b \n"
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [k] "i" (K), [step] "i" ((N / (K+1)) & ~7)
+        : "rax", "rcx", "cc", "memory");
+}
+
+REGISTER_PERM_NODE(List32BNodeRead0x64Loop, (ListNodeRead64Loop<32,0>), NULL, 8, 32);
+REGISTER_PERM_NODE(List32BNodeRead1x64Loop, (ListNodeRead64Loop<32,1>), NULL, 16, 32);
+REGISTER_PERM_NODE(List32BNodeRead2x64Loop, (ListNodeRead64Loop<32,2>), NULL, 24, 32);
+REGISTER_PERM_NODE(List32BNodeRead3x64Loop, (ListNodeRead64Loop<32,3>), NULL, 32, 32);
+REGISTER_PERM_NODE(List64BNodeRead0x64Loop, (ListNodeRead64Loop<64,0>), NULL, 8, 64);
+REGISTER_PERM_NODE(List64BNodeRead1x64Loop, (ListNodeRead64Loop<64,1>), NULL, 16, 64);
+REGISTER_PERM_NODE(List64BNodeRead2x64Loop, (ListNodeRead64Loop<64,2>), NULL, 24, 64);
+REGISTER_PERM_NODE(List64BNodeRead7x64Loop, (ListNodeRead64Loop<64,7>), NULL, 64, 64);
+REGISTER_PERM_NODE(List128BNodeRead0x64Loop, (ListNodeRead64Loop<128,0>), NULL, 8, 128);
+REGISTER_PERM_NODE(List128BNodeRead1x64Loop, (ListNodeRead64Loop<128,1>), NULL, 16, 128);
+REGISTER_PERM_NODE(List128BNodeRead4x64Loop, (ListNodeRead64Loop<128,4>), NULL, 40, 128);
+REGISTER_PERM_NODE(List128BNodeRead15x64Loop, (ListNodeRead64Loop<128,15>), NULL, 128, 128);
+REGISTER_PERM_NODE(List256BNodeRead0x64Loop, (ListNodeRead64Loop<256,0>), NULL, 8, 256);
+REGISTER_PERM_NODE(List256BNodeRead1x64Loop, (ListNodeRead64Loop<256,1>), NULL, 16, 256);
+REGISTER_PERM_NODE(List256BNodeRead8x64Loop, (ListNodeRead64Loop<256,8>), NULL, 72, 256);
+REGISTER_PERM_NODE(List256BNodeRead31x64Loop, (ListNodeRead64Loop<256,31>), NULL, 256, 256);
+REGISTER_PERM_NODE(List512BNodeRead0x64Loop, (ListNodeRead64Loop<512,0>), NULL, 8, 512);
+REGISTER_PERM_NODE(List512BNodeRead1x64Loop, (ListNodeRead64Loop<512,1>), NULL, 16, 512);
+REGISTER_PERM_NODE(List512BNodeRead16x64Loop, (ListNodeRead64Loop<512,16>), NULL, 136, 512);
+REGISTER_PERM_NODE(List512BNodeRead63x64Loop, (ListNodeRead64Loop<512,63>), NULL, 512, 512);
+
+// follow Chains independent 64-bit cycles at once, interleaved over the whole
+// area, to measure memory-level parallelism. The chains are kept in
+// registers r8-r15, all return to their first pointer together. (Assembler version)
+template <int Chains>
+void PermRead64ChainsLoop(char* memarea, size_t, size_t repeats)
+{
+    asm volatile(
+        "mov    %[memarea], %%rax \n"   // rax = first pointer of chain
+        ".irp   r, 8,9,10,11,12,13,14,15 \n"
+        ".if    \\r - 8 < %c[chains] \n"
+        "mov    %%rax, %%r\\r \n"
+        "add    %[stride], %%rax \n"    // advance to next chain
+        ".endif \n"
+        ".endr \n"
+        "1: \n" // start of repeat loop
+        "2: \n" // start of read loop
+        ".irp   r, 8,9,10,11,12,13,14,15 \n"
+        ".if    \\r - 8 < %c[chains] \n"
+        "mov    (%%r\\r), %%r\\r \n"
+        ".endif \n"
+        ".endr \n"
+        // test read loop condition
+        "cmp    %%r8, %[memarea] \n"    // compare to first iterator
+        "jne    2b \n"
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [stride] "r" (g_perm_stride), [chains] "i" (Chains)
+        : "rax", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "cc", "memory");
+}
+
+REGISTER_PERM_CHAINS(PermRead64Chains2Loop, PermRead64ChainsLoop<2>, NULL, 8, 2);
+REGISTER_PERM_CHAINS(PermRead64Chains4Loop, PermRead64ChainsLoop<4>, NULL, 8, 4);
+REGISTER_PERM_CHAINS(PermRead64Chains8Loop, PermRead64ChainsLoop<8>, NULL, 8, 8);
+
+// follow Chains independent 64-bit cycles at once, for more chains than free
+// registers: the chains are kept in an array on the stack, which adds an L1
+// load and store to each step. (Assembler version)
+template <int Chains>
+void PermRead64ChainsStackLoop(char* memarea, size_t, size_t repeats)
+{
+    char* chain[Chains];
+
+    for (int c = 0; c < Chains; ++c)
+        chain[c] = memarea + c * g_perm_stride;
+
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "2: \n" // start of read loop
+        ".set   .Lchain, 0 \n"
+        ".rept  %c[chains] \n"
+        "mov    .Lchain(%[chain]), %%rax \n"
+        "mov    (%%rax), %%rax \n"
+        "mov    %%rax, .Lchain(%[chain]) \n"
+        ".set   .Lchain, .Lchain + 8 \n"
+        ".endr \n"
+        // test read loop condition
+        "cmp    %[memarea], (%[chain]) \n" // compare to first iterator
+        "jne    2b \n"
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [chain] "r" (chain), [chains] "i" (Chains)
+        : "rax", "cc", "memory");
+}
+
+REGISTER_PERM_CHAINS(PermRead64Chains16Loop, PermRead64ChainsStackLoop<16>, NULL, 8, 16);
+REGISTER_PERM_CHAINS(PermRead64Chains32Loop, PermRead64ChainsStackLoop<32>, NULL, 8, 32);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Instruction Fetching
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// fill the area with straight-line 8-byte NOPs followed by a RET
+void prepareScanExec64NopLoop(int, char* memarea, size_t size)
+{
+    uint64_t* begin = (uint64_t*)memarea;
+    uint64_t* end = begin + size / sizeof(uint64_t) - 1;
+
+    for (uint64_t* p = begin; p < end; ++p)
+        *p = 0x0000000000841F0FLLU;     // nopl 0x0(%rax,%rax,1)
+
+    *end = 0xCCCCCCCCCCCCCCC3LLU;       // ret + int3 padding
+
+    clear_icache(memarea, size);
+}
+
+// call the generated straight-line code (Assembler version)
+void ScanExec64NopLoop(char* memarea, size_t, size_t repeats)
+{
+    asm volatile(
+        "sub    $128, %%rsp \n"         // skip red zone, the call pushes on it
+        "1: \n" // start of repeat loop
+        "call   *%[memarea] \n"         // run through the code area
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        "add    $128, %%rsp \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea)
+        : "cc", "memory");
+}
+
+REGISTER_EXEC(ScanExec64NopLoop, prepareScanExec64NopLoop, NULL, 8);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Memory Fences
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// fence instruction issued by ScanWrite64PtrFenceLoop after every K stores
+enum { FENCE_NONE, FENCE_SFENCE, FENCE_MFENCE, FENCE_LFENCE };
+
+// 64-bit (non-temporal) writer with a fence after every K stores (Assembler
+// version)
+template <bool NT, int Fence, int K>
+void ScanWrite64PtrFenceLoop(char* memarea, size_t size, size_t repeats)
+{
+    asm volatile(
+        "mov    $0xC0FFEEEEBABE0000, %%rax \n" // rax = test value
+        "1: \n" // start of repeat loop
+        "mov    %[memarea], %%rcx \n"   // rcx = reset loop iterator
+        "2: \n" // start of write loop
+        ".rept  %c[k] \n"               // K stores
+        ".if    %c[nt] \n"
+        "movnti %%rax, (%%rcx) \n"
+        ".else \n"
+        "mov    %%rax, (%%rcx) \n"
+        ".endif \n"
+        "add    $8, %%rcx \n"
+        ".endr \n"
+        ".if    %c[fence] == 1 \n"
+        "sfence \n"
+        ".elseif %c[fence] == 2 \n"
+        "mfence \n"
+        ".elseif %c[fence] == 3 \n"
+        "lfence \n"
+        ".endif \n"
+        // test write loop condition
+        "cmp    %[end], %%rcx \n"       // compare to end iterator
+        "jb     2b \n"
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        : [repeats] "+r" (repeats)
+        : [memarea] "r" (memarea), [end] "r" (memarea+size),
+          [nt] "i" (NT), [fence] "i" (Fence), [k] "i" (K)
+        : "rax", "rcx", "cc", "memory");
+}
+
+REGISTER_FENCE(ScanWrite64PtrSfence1Loop, (ScanWrite64PtrFenceLoop<false, FENCE_SFENCE, 1>),
+               (ScanWrite64PtrFenceLoop<false, FENCE_NONE, 1>), "sse", 8, 1);
+REGISTER_FENCE(ScanWrite64PtrSfence4Loop, (ScanWrite64PtrFenceLoop<false, FENCE_SFENCE, 4>),
+               (ScanWrite64PtrFenceLoop<false, FENCE_NONE, 4>), "sse", 8, 4);
+REGISTER_FENCE(ScanWrite64PtrSfence16Loop, (ScanWrite64PtrFenceLoop<false, FENCE_SFENCE, 16>),
+               (ScanWrite64PtrFenceLoop<false, FENCE_NONE, 16>), "sse", 8, 16);
+REGISTER_FENCE(ScanWrite64PtrSfence64Loop, (ScanWrite64PtrFenceLoop<false, FENCE_SFENCE, 64>),
+               (ScanWrite64PtrFenceLoop<false, FENCE_NONE, 64>), "sse", 8, 64);
+
+REGISTER_FENCE(ScanWrite64PtrMfence1Loop, (ScanWrite64PtrFenceLoop<false, FENCE_MFENCE, 1>),
+               (ScanWrite64PtrFenceLoop<false, FENCE_NONE, 1>), "sse2", 8, 1);
+REGISTER_FENCE(ScanWrite64PtrMfence4Loop, (ScanWrite64PtrFenceLoop<false, FENCE_MFENCE, 4>),
+               (ScanWrite64PtrFenceLoop<false, FENCE_NONE, 4>), "sse2", 8, 4);
+REGISTER_FENCE(ScanWrite64PtrMfence16Loop, (ScanWrite64PtrFenceLoop<false, FENCE_MFENCE, 16>),
+               (ScanWrite64PtrFenceLoop<false, FENCE_NONE, 16>), "sse2", 8, 16);
+REGISTER_FENCE(ScanWrite64PtrMfence64Loop, (ScanWrite64PtrFenceLoop<false, FENCE_MFENCE, 64>),
+               (ScanWrite64PtrFenceLoop<false, FENCE_NONE, 64>), "sse2", 8, 64);
+
+REGISTER_FENCE(ScanWrite64PtrLfence1Loop, (ScanWrite64PtrFenceLoop<false, FENCE_LFENCE, 1>),
+               (ScanWrite64PtrFenceLoop<false, FENCE_NONE, 1>), "sse2", 8, 1);
+REGISTER_FENCE(ScanWrite64PtrLfence4Loop, (ScanWrite64PtrFenceLoop<false, FENCE_LFENCE, 4>),
+               (ScanWrite64PtrFenceLoop<false, FENCE_NONE, 4>), "sse2", 8, 4);
+REGISTER_FENCE(ScanWrite64PtrLfence16Loop, (ScanWrite64PtrFenceLoop<false, FENCE_LFENCE, 16>),
+               (ScanWrite64PtrFenceLoop<false, FENCE_NONE, 16>), "sse2", 8, 16);
+REGISTER_FENCE(ScanWrite64PtrLfence64Loop, (ScanWrite64PtrFenceLoop<false, FENCE_LFENCE, 64>),
+               (ScanWrite64PtrFenceLoop<false, FENCE_NONE, 64>), "sse2", 8, 64);
+
+REGISTER_FENCE(ScanWriteNT64PtrSfence1Loop, (ScanWrite64PtrFenceLoop<true, FENCE_SFENCE, 1>),
+               (ScanWrite64PtrFenceLoop<true, FENCE_NONE, 1>), "sse2", 8, 1);
+REGISTER_FENCE(ScanWriteNT64PtrSfence4Loop, (ScanWrite64PtrFenceLoop<true, FENCE_SFENCE, 4>),
+               (ScanWrite64PtrFenceLoop<true, FENCE_NONE, 4>), "sse2", 8, 4);
+REGISTER_FENCE(ScanWriteNT64PtrSfence16Loop, (ScanWrite64PtrFenceLoop<true, FENCE_SFENCE, 16>),
+               (ScanWrite64PtrFenceLoop<true, FENCE_NONE, 16>), "sse2", 8, 16);
+REGISTER_FENCE(ScanWriteNT64PtrSfence64Loop, (ScanWrite64PtrFenceLoop<true, FENCE_SFENCE, 64>),
+               (ScanWrite64PtrFenceLoop<true, FENCE_NONE, 64>), "sse2", 8, 64);
+
+REGISTER_FENCE(ScanWriteNT64PtrMfence1Loop, (ScanWrite64PtrFenceLoop<true, FENCE_MFENCE, 1>),
+               (ScanWrite64PtrFenceLoop<true, FENCE_NONE, 1>), "sse2", 8, 1);
+REGISTER_FENCE(ScanWriteNT64PtrMfence4Loop, (ScanWrite64PtrFenceLoop<true, FENCE_MFENCE, 4>),
+               (ScanWrite64PtrFenceLoop<true, FENCE_NONE, 4>), "sse2", 8, 4);
+REGISTER_FENCE(ScanWriteNT64PtrMfence16Loop, (ScanWrite64PtrFenceLoop<true, FENCE_MFENCE, 16>),
+               (ScanWrite64PtrFenceLoop<true, FENCE_NONE, 16>), "sse2", 8, 16);
+REGISTER_FENCE(ScanWriteNT64PtrMfence64Loop, (ScanWrite64PtrFenceLoop<true, FENCE_MFENCE, 64>),
+               (ScanWrite64PtrFenceLoop<true, FENCE_NONE, 64>), "sse2", 8, 64);
+
+REGISTER_FENCE(ScanWriteNT64PtrLfence1Loop, (ScanWrite64PtrFenceLoop<true, FENCE_LFENCE, 1>),
+               (ScanWrite64PtrFenceLoop<true, FENCE_NONE, 1>), "sse2", 8, 1);
+REGISTER_FENCE(ScanWriteNT64PtrLfence4Loop, (ScanWrite64PtrFenceLoop<true, FENCE_LFENCE, 4>),
+               (ScanWrite64PtrFenceLoop<true, FENCE_NONE, 4>), "sse2", 8, 4);
+REGISTER_FENCE(ScanWriteNT64PtrLfence16Loop, (ScanWrite64PtrFenceLoop<true, FENCE_LFENCE, 16>),
+               (ScanWrite64PtrFenceLoop<true, FENCE_NONE, 16>), "sse2", 8, 16);
+REGISTER_FENCE(ScanWriteNT64PtrLfence64Loop, (ScanWrite64PtrFenceLoop<true, FENCE_LFENCE, 64>),
+               (ScanWrite64PtrFenceLoop<true, FENCE_NONE, 64>), "sse2", 8, 64);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// Random Pointer Streams: Zipf Distributed and Reuse Distance Driven Access
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// 64-bit reader of a prepared pointer stream (Assembler version)
+void StreamRead64PtrSimpleLoop(char*, size_t size, size_t repeats)
+{
+    char** stream = (char**)t_auxarea;
+
+    asm volatile(
+        "1: \n" // start of repeat loop
+        "mov    %[stream], %%rcx \n"    // rcx = reset stream iterator
+        "2: \n" // start of read loop
+        "mov    (%%rcx), %%rdx \n"      // rdx = next pointer in stream
+        "mov    (%%rdx), %%rax \n"
+        "add    $8, %%rcx \n"
+        // test read loop condition
+        "cmp    %[end], %%rcx \n"       // compare to end iterator
+        "jb     2b \n"
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        : [repeats] "+r" (repeats)
+        : [stream] "r" (stream), [end] "r" (stream + size / 64)
+        : "rax", "rcx", "rdx", "cc", "memory");
+}
+
+// 64-bit reader of a prepared pointer stream, where each read depends on the
+// previous one (Assembler version)
+void StreamRead64PtrDependLoop(char*, size_t size, size_t repeats)
+{
+    char** stream = (char**)t_auxarea;
+
+    asm volatile(
+        "xor    %%eax, %%eax \n"        // rax = zero
+        "1: \n" // start of repeat loop
+        "mov    %[stream], %%rcx \n"    // rcx = reset stream iterator
+        "2: \n" // start of read loop
+        "mov    (%%rcx), %%rdx \n"      // rdx = next pointer in stream
+        "add    %%rax, %%rdx \n"        // add zero from previous read
+        "mov    (%%rdx), %%rax \n"
+        "and    $0, %%rax \n"           // zero, but depending on the read
+        "add    $8, %%rcx \n"
+        // test read loop condition
+        "cmp    %[end], %%rcx \n"       // compare to end iterator
+        "jb     2b \n"
+        // test repeat loop condition
+        "dec    %[repeats] \n"          // until repeats = 0
+        "jnz    1b \n"
+        : [repeats] "+r" (repeats)
+        : [stream] "r" (stream), [end] "r" (stream + size / 64)
+        : "rax", "rcx", "rdx", "cc", "memory");
+}
+
+// read Zipf distributed pointer streams
+REGISTER_PREPARE_NAMED(ZipfRead64PtrSimpleLoop, StreamRead64PtrSimpleLoop, prepare_zipf_stream, NULL, 8, 64, 1);
+REGISTER_PREPARE_NAMED(ZipfRead64PtrDependLoop, StreamRead64PtrDependLoop, prepare_zipf_stream, NULL, 8, 64, 1);
+
+// read pointer streams with reuse distance histogram given by -D
+REGISTER_PREPARE_NAMED(ReuseRead64PtrSimpleLoop, StreamRead64PtrSimpleLoop, prepare_reuse_stream, NULL, 8, 64, 1);
+REGISTER_PREPARE_NAMED(ReuseRead64PtrDependLoop, StreamRead64PtrDependLoop, prepare_reuse_stream, NULL, 8, 64, 1);
+
+// -----------------------------------------------------------------------------
+
+// ****************************************************************************
+// ----------------------------------------------------------------------------
+// CRC32C Checksums: checksum the area with the SSE4.2 crc32 instruction in
+// one to three interleaved chains over consecutive segments, which hide the
+// instruction's latency of three cycles, and combine the chains' CRCs.
+// ----------------------------------------------------------------------------
+// ****************************************************************************
+
+// continue the CRC over [begin,end) in a single chain
+static inline uint64_t crc32c_chain1(const char* begin, const char* end, uint64_t crc)
+{
+    asm volatile(
+        "jmp    2f \n"
+        "1: \n" // start of checksum loop
+        "crc32q (%[p]), %[crc] \n"
+        "add    $8, %[p] \n"
+        "2: \n"
+        // test checksum loop condition
+        "cmp    %[end], %[p] \n"        // compare to end iterator
+        "jb     1b \n"
+        : [crc] "+r" (crc), [p] "+r" (begin)
+        : [end] "r" (end)
+        : "cc", "memory");
+    return crc;
+}
+
+// checksum in one chain (Assembler version)
+void Crc32c64Loop(char* memarea, size_t size, size_t repeats)
+{
+    do {
+        uint64_t crc = crc32c_chain1(memarea, memarea + size, 0xFFFFFFFF);
+        keep_value(crc ^ 0xFFFFFFFF);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_CPUFEAT(Crc32c64Loop, "sse42", 8, 8, 16);
+
+// checksum two halves in interleaved chains (Assembler version)
+void Crc32c64Way2Loop(char* memarea, size_t size, size_t repeats)
+{
+    size_t seg = size / 16 * 8;
+    uint32_t shift = crc32c_shift_factor(size - seg);
+
+    do {
+        uint64_t c0 = 0xFFFFFFFF, c1 = 0;
+        const char* p = memarea;
+
+        asm volatile(
+            "1: \n" // start of checksum loop
+            "crc32q (%[p]), %[c0] \n"
+            "crc32q (%[p],%[seg]), %[c1] \n"
+            "add    $8, %[p] \n"
+            // test checksum loop condition
+            "cmp    %[end], %[p] \n"    // compare to end of first segment
+            "jb     1b \n"
+            : [c0] "+r" (c0), [c1] "+r" (c1), [p] "+r" (p)
+            : [seg] "r" (seg), [end] "r" (memarea + seg)
+            : "cc", "memory");
+
+        c1 = crc32c_chain1(memarea + 2 * seg, memarea + size, c1);
+
+        uint32_t crc = crc32c_multiply(c0, shift) ^ c1;
+        keep_value(crc ^ 0xFFFFFFFF);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_CPUFEAT(Crc32c64Way2Loop, "sse42", 8, 8, 16);
+
+// checksum three thirds in interleaved chains (Assembler version)
+void Crc32c64Way3Loop(char* memarea, size_t size, size_t repeats)
+{
+    size_t seg = size / 24 * 8;
+    uint32_t shift1 = crc32c_shift_factor(seg);
+    uint32_t shift2 = crc32c_shift_factor(size - 2 * seg);
+
+    do {
+        uint64_t c0 = 0xFFFFFFFF, c1 = 0, c2 = 0;
+        const char* p = memarea;
+
+        asm volatile(
+            "1: \n" // start of checksum loop
+            "crc32q (%[p]), %[c0] \n"
+            "crc32q (%[p],%[seg]), %[c1] \n"
+            "crc32q (%[p],%[seg],2), %[c2] \n"
+            "add    $8, %[p] \n"
+            // test checksum loop condition
+            "cmp    %[end], %[p] \n"    // compare to end of first segment
+            "jb     1b \n"
+            : [c0] "+r" (c0), [c1] "+r" (c1), [c2] "+r" (c2), [p] "+r" (p)
+            : [seg] "r" (seg), [end] "r" (memarea + seg)
+            : "cc", "memory");
+
+        c2 = crc32c_chain1(memarea + 3 * seg, memarea + size, c2);
+
+        uint32_t crc = crc32c_multiply(crc32c_multiply(c0, shift1) ^ c1, shift2) ^ c2;
+        keep_value(crc ^ 0xFFFFFFFF);
+    }
+    while (--repeats != 0);
+}
+
+REGISTER_CPUFEAT(Crc32c64Way3Loop, "sse42", 8, 8, 16);
+
 // -----------------------------------------------------------------------------
@@ -30,19 +30,29 @@
 #include <fstream>
 #include <iomanip>
 #include <vector>
+#include <algorithm>
 
 #include <stdlib.h>
 #include <inttypes.h>
 #include <string.h>
 #include <assert.h>
 #include <unistd.h>
+#include <getopt.h>
 #include <time.h>
+#include <errno.h>
+#include <math.h>
 
 #include <pthread.h>
+#include <sched.h>
+#if __aarch64__ && __linux__
+#include <sys/auxv.h>
+#endif
 #include <malloc.h>
 
 #if ON_WINDOWS
 #include <windows.h>
+#else
+#include <sys/mman.h>
 #endif
 
 // -----------------------------------------------------------------------------
@@ -73,9 +83,48 @@ bool gopt_nthreads_quadratic = false;
 // option to test permutation cycle before measurement
 bool gopt_testcycle = false;
 
+// option to permute at cache line granularity: one pointer per line of
+// gopt_perm_linesize bytes instead of one per word, 0 = detected line size
+bool gopt_perm_lines = false;
+uint64_t gopt_perm_linesize = 0;
+
 // option to change the output file from default "stats.txt"
 const char* gopt_output_file = "stats.txt";
 
+// exponent of the Zipf distribution of Zipf test functions
+double gopt_zipf_exponent = 0.99;
+
+// seed of the random permutations and pointer streams, which thus only depend
+// on seed and size
+uint64_t gopt_seed = 233349568;
+
+// load factor of the hash tables of HashProbe test functions
+double gopt_hash_load = 0.7;
+
+// fraction of values qualifying the predicate of FilterCompact test functions
+double gopt_filter_selectivity = 0.5;
+
+// edge length of the square tiles of blocked Transpose test functions, in
+// elements, a multiple of eight such that tile rows fill whole cache lines
+uint64_t gopt_transpose_tile = 32;
+
+// number of nonzeros per row of the sparse matrices of SpMV test functions
+uint64_t gopt_spmv_nnz = 16;
+
+// mean literal run and match length, and maximum match distance (0 = whole
+// area) of the compressed streams of LZ test functions
+const char* gopt_lz_spec = "4,16,0";
+double gopt_lz_literals = 4;
+double gopt_lz_match = 16;
+uint64_t gopt_lz_maxdist = 0;
+
+// histogram of stack reuse distances of Reuse test functions
+const char* gopt_reuse_spec = "16K:0.4,256K:0.3,8M:0.2,inf:0.1";
+
+// option to back the memory area with huge pages (1), with small pages (0), or
+// to leave it to the system's default policy (-1)
+int gopt_hugepages = -1;
+
 // error writers
 #define ERR(x)  do { std::cerr << x << std::endl; } while(0)
 #define ERRX(x)  do { (std::cerr << x).flush(); } while(0)
@@ -87,17 +136,63 @@ size_t g_memsize = 0;
 // global test function currently run
 const struct TestFunction* g_func = NULL;
 
+// global current number of threads
+int g_nthreads = 0;
+
+// synchronization barrier for current thread counter
+pthread_barrier_t g_barrier;
+
 // number of physical cpus detected
 int g_physical_cpus;
 
+// size of a (small) virtual memory page
+size_t g_pagesize = 4096;
+
+// size of the per-core cache against which Stencil test functions evaluate the
+// layer conditions of their cache line traffic model
+size_t g_layer_cachesize = 1024 * 1024;
+
+// memory which cached permutation cycles may occupy besides the test area
+uint64_t g_perm_cache_budget = 0;
+
+// distance between the pointers of the current permutation layout: chain c of
+// the PERM_CHAINS layout starts at c times this distance into the area
+size_t g_perm_stride = sizeof(void*);
+
 // hostname
 char g_hostname[256];
 
+// additional key=value fields of the current test for the RESULT line
+std::string g_result_params;
+
+// name and number per thread and repeat of the operations of the current test,
+// e.g. lookups, if they differ from the memory accesses
+const char* g_ops_name = NULL;
+uint64_t g_ops_per_repeat = 0;
+
+// number of bytes per thread and repeat the current test actually accesses, if
+// less than its area, or zero if it sweeps the whole area
+uint64_t g_touched_size = 0;
+
 // -----------------------------------------------------------------------------
 // --- Registry for Memory Testing Functions
 
 typedef void (*testfunc_type)(char* memarea, size_t size, size_t repeats);
 
+typedef void (*preparefunc_type)(int thread_num, char* memarea, size_t size);
+
+// layout of the permutation cycle filled into the area before calling the func
+enum perm_layout_type
+{
+    PERM_NONE = 0,      // no permutation, the func scans the area
+    PERM_WORD,          // all words of the area form the cycle
+    PERM_PAGE,          // one word per page, in varying cache lines
+    PERM_BLOCK,         // one word per block of access_offset bytes
+    PERM_PAGE_RANDOM,   // one word per line, pages random, lines in order
+    PERM_LINE_RANDOM,   // one word per line, pages in order, lines random
+    PERM_CHAINS         // all words, unroll_factor interleaved cycles
+};
+
 struct TestFunction
 {
     // identifier of the test function
@@ -118,13 +213,27 @@ struct TestFunction
     // number of accesses before and after
     unsigned int unroll_factor;
 
-    // fill the area with a permutation before calling the func
-    bool make_permutation;
+    // fill the area with a permutation of this layout before calling the func
+    perm_layout_type perm_layout;
+
+    // function to prepare the area of each thread before calling the func
+    preparefunc_type prepare;
+
+    // number of accesses between two memory fences, 0 = no fences
+    unsigned int fence_interval;
+
+    // same accesses as func without the memory fences, which is timed after
+    // func to separate the fences' cost from the stores'
+    testfunc_type fence_baseline;
+
+    // func runs code generated into the area, which must be executable
+    bool exec_area;
 
     // constructor which also registers the function
     TestFunction(const char* n, testfunc_type f, const char* cf,
                  unsigned int bpa, unsigned int ao, unsigned int unr,
-                 bool mp);
+                 perm_layout_type pl, preparefunc_type pf,
+                 unsigned int fi, testfunc_type fb = NULL, bool ex = false);
 
     // test CPU feature support
     bool is_supported() const;
@@ -134,25 +243,596 @@ std::vector<TestFunction*> g_testlist;
 
 TestFunction::TestFunction(const char* n, testfunc_type f, const char* cf,
                            unsigned int bpa, unsigned int ao, unsigned int unr,
-                           bool mp)
+                           perm_layout_type pl, preparefunc_type pf,
+                           unsigned int fi, testfunc_type fb, bool ex)
     : name(n), func(f), cpufeat(cf),
       bytes_per_access(bpa), access_offset(ao), unroll_factor(unr),
-      make_permutation(mp)
+      perm_layout(pl), prepare(pf), fence_interval(fi), fence_baseline(fb),
+      exec_area(ex)
 {
     g_testlist.push_back(this);
 }
 
 #define REGISTER(func, bytes, offset, unroll)                   \
     static const struct TestFunction* _##func##_register =       \
-        new TestFunction(#func,func,NULL,bytes,offset,unroll,false);
+        new TestFunction(#func,func,NULL,bytes,offset,unroll,PERM_NONE,NULL,0);
 
 #define REGISTER_CPUFEAT(func, cpufeat, bytes, offset, unroll)  \
     static const struct TestFunction* _##func##_register =       \
-        new TestFunction(#func,func,cpufeat,bytes,offset,unroll,false);
+        new TestFunction(#func,func,cpufeat,bytes,offset,unroll,PERM_NONE,NULL,0);
+
+// register a func under a different name, e.g. a template instance
+#define REGISTER_NAMED(name, func, cpufeat, bytes, offset, unroll) \
+    static const struct TestFunction* _##name##_register =       \
+        new TestFunction(#name,func,cpufeat,bytes,offset,unroll,PERM_NONE,NULL,0);
 
 #define REGISTER_PERM(func, bytes)                              \
     static const struct TestFunction* _##func##_register =       \
-        new TestFunction(#func,func,NULL,bytes,bytes,1,true);
+        new TestFunction(#func,func,NULL,bytes,bytes,1,PERM_WORD,NULL,0);
+
+// register a permutation walking func under a different name and layout
+#define REGISTER_PERM_LAYOUT(name, func, bytes, layout)         \
+    static const struct TestFunction* _##name##_register =       \
+        new TestFunction(#name,func,NULL,bytes,bytes,1,layout,NULL,0);
+
+#define REGISTER_PREPARE(func, prepare, cpufeat, bytes, offset, unroll) \
+    static const struct TestFunction* _##func##_register =       \
+        new TestFunction(#func,func,cpufeat,bytes,offset,unroll,PERM_NONE,prepare,0);
+
+// register a func which runs the code its prepare function generates
+#define REGISTER_EXEC(func, prepare, cpufeat, bytes)             \
+    static const struct TestFunction* _##func##_register =       \
+        new TestFunction(#func,func,cpufeat,bytes,bytes,1,PERM_NONE,prepare,0,NULL,true);
+
+// register a func with prepare function under a different name
+#define REGISTER_PREPARE_NAMED(name, func, prepare, cpufeat, bytes, offset, unroll) \
+    static const struct TestFunction* _##name##_register =       \
+        new TestFunction(#name,func,cpufeat,bytes,offset,unroll,PERM_NONE,prepare,0);
+
+// register a permutation walking func which reads whole blocks of bytes
+#define REGISTER_PERM_BLOCK(name, func, cpufeat, bytes)         \
+    static const struct TestFunction* _##name##_register =       \
+        new TestFunction(#name,func,cpufeat,bytes,bytes,1,PERM_BLOCK,NULL,0);
+
+// register a linked list walking func which reads bytes of each node
+#define REGISTER_PERM_NODE(name, func, cpufeat, bytes, nodesize)   \
+    static const struct TestFunction* _##name##_register =       \
+        new TestFunction(#name,func,cpufeat,bytes,nodesize,1,PERM_BLOCK,NULL,0);
+
+// register a permutation walking func which follows chains independent cycles
+// at once, interleaved over the whole area
+#define REGISTER_PERM_CHAINS(name, func, cpufeat, bytes, chains) \
+    static const struct TestFunction* _##name##_register =       \
+        new TestFunction(#name,func,cpufeat,bytes,bytes,chains,PERM_CHAINS,NULL,0);
+
+// register a func with a memory fence after every interval accesses, and the
+// baseline func doing the same accesses without fences
+#define REGISTER_FENCE(name, func, baseline, cpufeat, bytes, interval) \
+    static const struct TestFunction* _##name##_register =       \
+        new TestFunction(#name,func,cpufeat,bytes,bytes,interval,PERM_NONE,NULL,interval,baseline);
+
+// -----------------------------------------------------------------------------
+// --- Some Simple Subroutines
+
+// parse a number as size_t with error detection
+static inline bool
+parse_uint64t(const char* value, uint64_t& out)
+{
+    char* endp;
+    out = strtoull(value, &endp, 10);
+    return (endp && *endp == 0);
+}
+
+// parse a number as int with error detection
+static inline bool
+parse_int(const char* value, int& out)
+{
+    char* endp;
+    out = strtoul(value, &endp, 10);
+    return (endp && *endp == 0);
+}
+
+// parse a floating point number with error detection
+static inline bool
+parse_double(const char* value, double& out)
+{
+    char* endp;
+    out = strtod(value, &endp);
+    return (endp && *endp == 0);
+}
+
+// keep the compiler from optimizing away the computation of a value
+static inline void keep_value(uint64_t value)
+{
+    asm volatile("" : : "r" (value));
+}
+
+// Simple linear congruential random generator
+struct LCGRandom
+{
+    uint64_t      xn;
+
+    inline LCGRandom(uint64_t seed) : xn(seed) { }
+
+    inline uint64_t operator()()
+    {
+        xn = 0x27BB2EE687B0B0FDLLU * xn + 0xB504F32DLU;
+        return xn;
+    }
+};
+
+// return a random number in [0,n) from the high bits of the generator, using a
+// multiply-shift instead of a slow 64-bit modulo
+static inline uint64_t random_below(LCGRandom& rnd, uint64_t n)
+{
+#if __SIZEOF_INT128__
+    return (uint64_t)(((unsigned __int128)rnd() * n) >> 64);
+#else
+    if (n <= 0xFFFFFFFFLLU) return ((rnd() >> 32) * n) >> 32;
+    return rnd() % n;
+#endif
+}
+
+// return time stamp for time measurement
+static inline double timestamp()
+{
+    struct timespec ts;
+#ifdef __bgq__
+    // CLOCK_MONOTONIC is not supported on BG/Q
+    clock_gettime(CLOCK_REALTIME, &ts);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// add a key=value field to the RESULT line of the current test, called by
+// prepare functions on thread 0.
+template <typename Type>
+static inline void result_param(int thread_num, const char* key, const Type& value)
+{
+    if (thread_num != 0) return;
+
+    std::ostringstream os;
+    os << '\t' << key << '=' << value;
+    g_result_params += os.str();
+}
+
+// set the name and number of operations per repeat of the current test, which
+// are reported as ops and opsrate in the RESULT line, called by prepare
+// functions on thread 0.
+static inline void result_ops(int thread_num, const char* name, uint64_t count)
+{
+    if (thread_num != 0) return;
+
+    g_ops_name = name;
+    g_ops_per_repeat = count;
+}
+
+// set the number of bytes per repeat which the current test accesses of its
+// area, if it does not sweep all of it, called by prepare functions on thread
+// 0. testvol, testaccess and bandwidth are then computed from this size.
+static inline void result_touched(int thread_num, uint64_t size)
+{
+    if (thread_num != 0) return;
+
+    g_touched_size = size;
+}
+
+// return true if the funcname is selected via command line arguments
+static inline bool match_funcfilter(const char* funcname)
+{
+    if (gopt_funcfilter.size() == 0) return true;
+
+    // iterate over gopt_funcfilter list
+    for (size_t i = 0; i < gopt_funcfilter.size(); ++i) {
+        if (strstr(funcname, gopt_funcfilter[i]) != NULL)
+            return true;
+    }
+
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// --- Executable Memory for Generated Code
+
+// make the whole memory area executable for funcs running generated code, or
+// only readable and writable again afterwards
+static bool protect_memarea(bool exec)
+{
+#if !ON_WINDOWS
+    // mprotect() only works on whole pages
+    uintptr_t begin = (uintptr_t)g_memarea & ~(uintptr_t)(g_pagesize - 1);
+    uintptr_t end = (uintptr_t)g_memarea + g_memsize;
+
+    int prot = PROT_READ | PROT_WRITE | (exec ? PROT_EXEC : 0);
+
+    if (mprotect((void*)begin, end - begin, prot) != 0) {
+        ERR("Error setting memory area protection: " << strerror(errno));
+        return false;
+    }
+#else
+    DWORD oldprotect;
+    if (!VirtualProtect(g_memarea, g_memsize,
+                        exec ? PAGE_EXECUTE_READWRITE : PAGE_READWRITE, &oldprotect)) {
+        ERR("Error setting memory area protection.");
+        return false;
+    }
+#endif
+    return true;
+}
+
+// synchronize the instruction cache after code was generated into the area,
+// on architectures which require it
+static inline void clear_icache(char* memarea, size_t size)
+{
+    __builtin___clear_cache(memarea, memarea + size);
+}
+
+// -----------------------------------------------------------------------------
+// --- Cooperating Threads
+
+// number of the thread running the func, for funcs in which all threads
+// cooperate on one array spread over their areas
+static __thread int t_thread_num = 0;
+
+// -----------------------------------------------------------------------------
+// --- Per-Thread Auxiliary Memory
+
+// auxiliary memory of each thread, e.g. for index streams read by the func
+static __thread char* t_auxarea = NULL;
+static __thread size_t t_auxsize = 0;
+
+// return the thread's auxiliary memory area, enlarged to at least size bytes
+static char* thread_auxarea(size_t size)
+{
+    if (t_auxsize < size)
+    {
+        free(t_auxarea);
+
+        t_auxsize = size;
+        t_auxarea = (char*)malloc(t_auxsize);
+
+        if (!t_auxarea) {
+            ERR("Error allocating auxiliary memory of " << size << " bytes.");
+            exit(EXIT_FAILURE);
+        }
+    }
+    return t_auxarea;
+}
+
+// release the thread's auxiliary memory before the thread terminates
+static void thread_auxarea_free()
+{
+    free(t_auxarea);
+    t_auxarea = NULL;
+    t_auxsize = 0;
+}
+
+// -----------------------------------------------------------------------------
+// --- Random Pointer Streams
+
+// Zipf distributed random generator of ranks 1..n with P(k) ~ 1/k^exponent,
+// using rejection-inversion sampling (Hoermann and Derflinger, 1996), which
+// requires no tables.
+struct ZipfRandom
+{
+    LCGRandom   rng;
+    double      n, exponent;
+    double      hx1, hn, s;
+
+    ZipfRandom(uint64_t seed, uint64_t _n, double _exponent)
+        : rng(seed), n(_n), exponent(_exponent)
+    {
+        hx1 = hint(1.5) - 1.0;
+        hn = hint(n + 0.5);
+        s = 2.0 - hint_inverse(hint(2.5) - h(2.0));
+    }
+
+    // log(1+x)/x, stable for small x
+    static double helper1(double x) {
+        return (fabs(x) > 1e-8) ? log1p(x) / x : 1.0 - x * (0.5 - x * (1.0/3.0 - 0.25 * x));
+    }
+
+    // (exp(x)-1)/x, stable for small x
+    static double helper2(double x) {
+        return (fabs(x) > 1e-8) ? expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x * 1.0/3.0 * (1.0 + 0.25 * x));
+    }
+
+    double h(double x) const {
+        return exp(-exponent * log(x));
+    }
+
+    double hint(double x) const {
+        double logx = log(x);
+        return helper2((1.0 - exponent) * logx) * logx;
+    }
+
+    double hint_inverse(double x) const {
+        double t = x * (1.0 - exponent);
+        if (t < -1.0) t = -1.0;
+        return exp(helper1(t) * x);
+    }
+
+    // uniform random value in [0,1)
+    double uniform() {
+        return (rng() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // draw a rank in 1..n
+    uint64_t operator()()
+    {
+        while (1)
+        {
+            double u = hn + uniform() * (hx1 - hn);
+            double x = hint_inverse(u);
+
+            double k = floor(x + 0.5);
+            if (k < 1.0) k = 1.0;
+            else if (k > n) k = n;
+
+            if (k - x <= s || u >= hint(k + 0.5) - h(k))
+                return (uint64_t)k;
+        }
+    }
+};
+
+// greatest common divisor
+static inline uint64_t gcd(uint64_t a, uint64_t b)
+{
+    while (b != 0) { uint64_t t = a % b; a = b; b = t; }
+    return a;
+}
+
+// (a * b) mod n without overflow
+static inline uint64_t mulmod(uint64_t a, uint64_t b, uint64_t n)
+{
+#if __SIZEOF_INT128__
+    return (uint64_t)((unsigned __int128)a * b % n);
+#else
+    uint64_t r = 0;
+    for (a %= n; b != 0; b >>= 1) {
+        if (b & 1) r = (r >= n - a) ? r - (n - a) : r + a;
+        a = (a >= n - a) ? a - (n - a) : a + a;
+    }
+    return r;
+#endif
+}
+
+// return a number coprime to the number of lines, by which line indexes are
+// multiplied to scatter them over the area
+static inline uint64_t scatter_factor(uint64_t lines)
+{
+    uint64_t scatter = (0x9E3779B97F4A7C15LLU % lines) | 1;
+    while (gcd(scatter, lines) != 1) scatter += 2;
+    return scatter;
+}
+
+// Fill the thread's auxiliary area with a stream of pointers to the cache
+// lines of the area, one per line, drawn from a Zipf distribution. Ranks are
+// scattered over the area, such that the hot set is not contiguous.
+void prepare_zipf_stream(int thread_num, char* memarea, size_t size)
+{
+    uint64_t lines = size / 64;
+    char** stream = (char**)thread_auxarea(lines * sizeof(char*));
+
+    result_param(thread_num, "zipf", gopt_zipf_exponent);
+    result_param(thread_num, "seed", gopt_seed);
+
+    uint64_t scatter = scatter_factor(lines);
+
+    if (gopt_zipf_exponent == 0)
+    {
+        LCGRandom srnd(gopt_seed);
+
+        for (uint64_t i = 0; i < lines; ++i)
+            stream[i] = memarea + (srnd() >> 11) % lines * 64;
+    }
+    else
+    {
+        ZipfRandom zrnd(gopt_seed, lines, gopt_zipf_exponent);
+
+        for (uint64_t i = 0; i < lines; ++i)
+            stream[i] = memarea + mulmod(zrnd() - 1, scatter, lines) * 64;
+    }
+}
+
+// one bucket of the reuse distance histogram: distances up to and including
+// maxdist cache lines (0 = infinite) are drawn with the cumulative probability.
+struct ReuseBucket
+{
+    uint64_t    maxdist;
+    double      cumprob;
+};
+
+std::vector<ReuseBucket> g_reuse_histogram;
+
+// Parse a reuse distance histogram like "16K:0.4,256K:0.3,inf:0.3" into
+// g_reuse_histogram. Each entry is the upper bound of the stack distance in
+// bytes (with suffix K, M or G) or "inf" for cold lines, and its weight. At
+// most one "inf" entry may be given, and it must be the last.
+static bool parse_reuse_spec(const char* spec)
+{
+    std::vector<ReuseBucket> hist;
+    double total = 0;
+    uint64_t prevdist = 0;
+
+    while (*spec)
+    {
+        ReuseBucket b;
+        char* endp;
+
+        if (strncmp(spec, "inf:", 4) == 0) {
+            // only one "inf" bucket, as later ones cannot be told apart
+            if (hist.size() && hist.back().maxdist == 0) return false;
+            b.maxdist = 0;
+            spec += 3;
+        }
+        else {
+            uint64_t dist = strtoull(spec, &endp, 10);
+            if (endp == spec) return false;
+            spec = endp;
+
+            if (*spec == 'K') dist *= 1024, ++spec;
+            else if (*spec == 'M') dist *= 1024*1024, ++spec;
+            else if (*spec == 'G') dist *= 1024*1024*1024LLU, ++spec;
+
+            // distances must be increasing and precede "inf"
+            b.maxdist = std::max<uint64_t>(dist / 64, 1);
+            if (b.maxdist <= prevdist) return false;
+            if (hist.size() && hist.back().maxdist == 0) return false;
+            prevdist = b.maxdist;
+        }
+
+        if (*spec++ != ':') return false;
+
+        double weight = strtod(spec, &endp);
+        if (endp == spec || weight < 0) return false;
+        spec = endp;
+
+        total += weight;
+        b.cumprob = total;
+        hist.push_back(b);
+
+        if (*spec == ',') ++spec;
+        else if (*spec != 0) return false;
+    }
+
+    if (hist.size() == 0 || total <= 0) return false;
+
+    for (size_t i = 0; i < hist.size(); ++i)
+        hist[i].cumprob /= total;
+
+    g_reuse_histogram.swap(hist);
+    return true;
+}
+
+// Fenwick tree counting marked time slots, to find the slot holding the k-th
+// most recent access in logarithmic time.
+struct FenwickTree
+{
+    std::vector<uint64_t> tree;
+    size_t logsize;
+
+    FenwickTree(size_t n) : logsize(0)
+    {
+        while (((size_t)1 << logsize) < n) ++logsize;
+        tree.resize(((size_t)1 << logsize) + 1, 0);
+    }
+
+    void add(size_t i, int v) {
+        for (++i; i < tree.size(); i += i & (~i + 1)) tree[i] += v;
+    }
+
+    // return the slot of the k-th marked slot (1-based) in ascending order
+    size_t find(size_t k) const
+    {
+        size_t pos = 0;
+        for (size_t step = (size_t)1 << logsize; step != 0; step >>= 1)
+        {
+            if (pos + step < tree.size() && tree[pos + step] < k) {
+                pos += step;
+                k -= tree[pos];
+            }
+        }
+        return pos;
+    }
+};
+
+// Fill the thread's auxiliary area with a stream of pointers to the cache
+// lines of the area, one per line, whose stack reuse distances follow the
+// histogram set by -D. The stream simulates an LRU stack: an access with
+// distance d touches the line which has d other lines accessed after its
+// last use. Cold accesses, or ones deeper than the stack, touch a new line,
+// or the least recently used one if all lines were touched.
+void prepare_reuse_stream(int thread_num, char* memarea, size_t size)
+{
+    uint64_t lines = size / 64;
+    char** stream = (char**)thread_auxarea(lines * sizeof(char*));
+
+    result_param(thread_num, "reuse", gopt_reuse_spec);
+    result_param(thread_num, "seed", gopt_seed);
+
+    uint64_t scatter = scatter_factor(lines);
+    uint64_t nextline = 0, stacksize = 0;
+
+    FenwickTree stack(lines);
+    std::vector<uint64_t> owner(lines);    // line accessed at each time slot
+
+    LCGRandom srnd(gopt_seed);
+
+    for (uint64_t now = 0; now < lines; ++now)
+    {
+        // select bucket and draw a distance uniformly inside it
+        double p = (srnd() >> 11) * (1.0 / 9007199254740992.0);
+
+        size_t b = 0;
+        while (b + 1 < g_reuse_histogram.size() && g_reuse_histogram[b].cumprob <= p) ++b;
+
+        uint64_t maxdist = g_reuse_histogram[b].maxdist;
+        uint64_t mindist = (b == 0) ? 0 : g_reuse_histogram[b-1].maxdist + 1;
+        uint64_t dist = (maxdist == 0) ? stacksize
+            : mindist + (srnd() >> 11) % (maxdist - mindist + 1);
+
+        uint64_t line;
+
+        if (dist >= stacksize && nextline < lines)
+        {
+            // cold access: touch a new line
+            line = mulmod(nextline++, scatter, lines);
+            ++stacksize;
+        }
+        else
+        {
+            if (dist >= stacksize) dist = stacksize - 1;
+
+            // the line whose last access has dist more recent ones
+            size_t slot = stack.find(stacksize - dist);
+            line = owner[slot];
+            stack.add(slot, -1);
+        }
+
+        owner[now] = line;
+        stack.add(now, +1);
+
+        stream[now] = memarea + line * 64;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// --- CRC32C Combination
+
+// Checksum funcs run the crc32c instructions, which neither invert the initial
+// nor the final value, in interleaved chains over consecutive segments. The
+// raw CRC of a concatenation is then the CRC of the first segment shifted over
+// the length of the second, xor the CRC of the second. Polynomials are bit
+// reflected: x^0 is the most significant bit.
+
+// multiply a and b modulo the CRC32C polynomial
+static inline uint32_t crc32c_multiply(uint32_t a, uint32_t b)
+{
+    uint32_t prod = 0;
+    for (int i = 0; i < 32; ++i)
+    {
+        if (a & 0x80000000) prod ^= b;
+        a <<= 1;
+        b = (b >> 1) ^ ((b & 1) ? 0x82F63B78 : 0);
+    }
+    return prod;
+}
+
+// return x^(8*bytes) modulo the CRC32C polynomial, which shifts a CRC over
+// bytes zero bytes
+static inline uint32_t crc32c_shift_factor(uint64_t bytes)
+{
+    uint32_t result = 0x80000000, power = 0x40000000;    // x^0 and x^1
+    for (uint64_t n = 8 * bytes; n != 0; n >>= 1)
+    {
+        if (n & 1) result = crc32c_multiply(result, power);
+        power = crc32c_multiply(power, power);
+    }
+    return result;
+}
 
 // -----------------------------------------------------------------------------
 // --- Test Functions with Inline Assembler Loops
@@ -169,6 +849,9 @@ TestFunction::TestFunction(const char* n, testfunc_type f, const char* cf,
   #include "funcs_c.h"
 #endif
 
+#include "funcs_apps.h"
+#include "funcs_libc.h"
+
 // -----------------------------------------------------------------------------
 // --- Test CPU Features via CPUID
 
@@ -178,12 +861,13 @@ static inline void cpuid(int op, int out[4])
 {
     asm volatile("cpuid"
                  : "=a" (out[0]), "=b" (out[1]), "=c" (out[2]), "=d" (out[3])
-                 : "a" (op)
+                 : "a" (op), "c" (0)
         );
 }
 
-// cpuid op 1 result
+// cpuid op 1 and op 7 (sub-leaf 0) results
 int g_cpuid_op1[4];
+int g_cpuid_op7[4];
 
 // check for MMX instructions
 static bool cpuid_mmx()
@@ -197,21 +881,60 @@ static bool cpuid_sse()
     return (g_cpuid_op1[3] & ((int)1 << 25));
 }
 
+// check for SSE2 instructions
+static bool cpuid_sse2()
+{
+    return (g_cpuid_op1[3] & ((int)1 << 26));
+}
+
 // check for AVX instructions
 static bool cpuid_avx()
 {
     return (g_cpuid_op1[2] & ((int)1 << 28));
 }
 
+// check for SSSE3 instructions
+static bool cpuid_ssse3()
+{
+    return (g_cpuid_op1[2] & ((int)1 << 9));
+}
+
+// check for SSE4.2 instructions
+static bool cpuid_sse42()
+{
+    return (g_cpuid_op1[2] & ((int)1 << 20));
+}
+
+// check for AVX2 instructions
+static bool cpuid_avx2()
+{
+    return (g_cpuid_op7[1] & ((int)1 << 5));
+}
+
+// check for AVX-512 foundation instructions
+static bool cpuid_avx512f()
+{
+    return (g_cpuid_op7[1] & ((int)1 << 16));
+}
+
 // run CPUID and print output
 static void cpuid_detect()
 {
     ERRX("CPUID:");
     cpuid(1, g_cpuid_op1);
 
+    int op0[4];
+    cpuid(0, op0);
+    if (op0[0] >= 7) cpuid(7, g_cpuid_op7);
+
     if (cpuid_mmx()) ERRX(" mmx");
     if (cpuid_sse()) ERRX(" sse");
+    if (cpuid_sse2()) ERRX(" sse2");
+    if (cpuid_ssse3()) ERRX(" ssse3");
+    if (cpuid_sse42()) ERRX(" sse42");
     if (cpuid_avx()) ERRX(" avx");
+    if (cpuid_avx2()) ERRX(" avx2");
+    if (cpuid_avx512f()) ERRX(" avx512f");
     ERR("");
 }
 
@@ -221,80 +944,92 @@ bool TestFunction::is_supported() const
     if (!cpufeat) return true;
     if (strcmp(cpufeat,"mmx") == 0) return cpuid_mmx();
     if (strcmp(cpufeat,"sse") == 0) return cpuid_sse();
+    if (strcmp(cpufeat,"sse2") == 0) return cpuid_sse2();
+    if (strcmp(cpufeat,"ssse3") == 0) return cpuid_ssse3();
+    if (strcmp(cpufeat,"sse42") == 0) return cpuid_sse42();
     if (strcmp(cpufeat,"avx") == 0) return cpuid_avx();
+    if (strcmp(cpufeat,"avx2") == 0) return cpuid_avx2();
+    if (strcmp(cpufeat,"avx512f") == 0) return cpuid_avx512f();
     return false;
 }
-#else
-static void cpuid_detect()
+#elif __aarch64__ && __linux__
+// check for CRC32 instructions in the hardware capabilities of the kernel
+static bool hwcap_crc32()
 {
-    // replace functions with dummys
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+    return (getauxval(AT_HWCAP) & HWCAP_CRC32);
 }
-bool TestFunction::is_supported() const
+
+// check that DC ZVA may be used: DCZID_EL0.DZP prohibits it if set
+static bool dczid_zva()
 {
-    return true;
+    uint64_t dczid;
+    asm volatile("mrs %0, dczid_el0" : "=r" (dczid));
+    return !(dczid & 0x10);
 }
-#endif
-
-// -----------------------------------------------------------------------------
-// --- Some Simple Subroutines
 
-// parse a number as size_t with error detection
-static inline bool
-parse_uint64t(const char* value, uint64_t& out)
+// print hardware capabilities
+static void cpuid_detect()
 {
-    char* endp;
-    out = strtoull(value, &endp, 10);
-    return (endp && *endp == 0);
+    ERRX("HWCAP:");
+    if (hwcap_crc32()) ERRX(" crc32");
+    if (dczid_zva()) ERRX(" dczva");
+    ERR("");
 }
 
-// parse a number as int with error detection
-static inline bool
-parse_int(const char* value, int& out)
+// TestFunction feature detection
+bool TestFunction::is_supported() const
 {
-    char* endp;
-    out = strtoul(value, &endp, 10);
-    return (endp && *endp == 0);
+    if (!cpufeat) return true;
+    if (strcmp(cpufeat,"crc32") == 0) return hwcap_crc32();
+    if (strcmp(cpufeat,"dczva") == 0) return dczid_zva();
+    return false;
 }
-
-// Simple linear congruential random generator
-struct LCGRandom
+#else
+static void cpuid_detect()
 {
-    uint64_t      xn;
-
-    inline LCGRandom(uint64_t seed) : xn(seed) { }
-
-    inline uint64_t operator()()
-    {
-        xn = 0x27BB2EE687B0B0FDLLU * xn + 0xB504F32DLU;
-        return xn;
-    }
-};
-
-// return time stamp for time measurement
-static inline double timestamp()
+    // replace functions with dummys
+}
+bool TestFunction::is_supported() const
 {
-    struct timespec ts;
-#ifdef __bgq__
-    // CLOCK_MONOTONIC is not supported on BG/Q
-    clock_gettime(CLOCK_REALTIME, &ts);
-#else
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-#endif
-    return ts.tv_sec + ts.tv_nsec * 1e-9;
+    return true;
 }
+#endif
 
-// return true if the funcname is selected via command line arguments
-static inline bool match_funcfilter(const char* funcname)
-{
-    if (gopt_funcfilter.size() == 0) return true;
+// -----------------------------------------------------------------------------
+// --- Detect Cache Line and Cache Size
 
-    // iterate over gopt_funcfilter list
-    for (size_t i = 0; i < gopt_funcfilter.size(); ++i) {
-        if (strstr(funcname, gopt_funcfilter[i]) != NULL)
-            return true;
-    }
+// return the L1 data cache line size, or 64 bytes if it cannot be detected
+static size_t detect_cache_linesize()
+{
+#if defined(_SC_LEVEL1_DCACHE_LINESIZE)
+    long linesize = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+    if (linesize > 0) return linesize;
+#endif
+#if defined(__i386__) || defined (__x86_64__)
+    // CLFLUSH line size in 8-byte units
+    int out[4];
+    cpuid(1, out);
+    if ((out[1] >> 8) & 0xFF) return ((out[1] >> 8) & 0xFF) * 8;
+#elif __aarch64__
+    // CTR_EL0.DminLine is the log2 of the number of 4-byte words per line
+    uint64_t ctr;
+    asm volatile("mrs %0, ctr_el0" : "=r" (ctr));
+    return (size_t)4 << ((ctr >> 16) & 0xF);
+#endif
+    return 64;
+}
 
-    return false;
+// return the size of the L2 cache, or 1 MiB if it cannot be detected
+static size_t detect_l2_cachesize()
+{
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+    long cachesize = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (cachesize > 0) return cachesize;
+#endif
+    return 1024 * 1024;
 }
 
 // -----------------------------------------------------------------------------
@@ -370,72 +1105,401 @@ const uint64_t areasize_list[] = {
 // flag for terminating current test
 bool g_done;
 
-// global current number of threads
-int g_nthreads = 0;
-
-// synchronization barrier for current thread counter
-pthread_barrier_t g_barrier;
-
 // thread shared parameters for test function
 uint64_t g_thrsize;
 uint64_t g_thrsize_spaced;
 uint64_t g_repeats;
 
-// Create a one-cycle permutation of pointers in the memory area
-void make_cyclic_permutation(int thread_num, void* memarea, size_t bytesize)
+// return the distance between two pointers of the func's permutation layout
+static inline size_t perm_layout_stride(const TestFunction* func)
+{
+    if (func->perm_layout == PERM_PAGE) return g_pagesize;
+    if (func->perm_layout == PERM_BLOCK) return func->access_offset;
+    if (func->perm_layout == PERM_PAGE_RANDOM || func->perm_layout == PERM_LINE_RANDOM)
+        return gopt_perm_lines ? gopt_perm_linesize : 64;
+    if (gopt_perm_lines) return gopt_perm_linesize;
+    return sizeof(void*);
+}
+
+// return address of the i-th pointer of a permutation layout in the area
+static inline void** perm_slot(char* area, size_t i, size_t stride, size_t spread)
+{
+    return (void**)(area + i * stride + (spread > 1 ? (i % spread) * 64 : 0));
+}
+
+// Link the lines of the area into one cycle which is structured by pages:
+// either the pages are visited in random order and the lines of each page in
+// order, or the pages in order and the lines of each page in random order.
+static void link_page_structured_cycle(char* area, size_t size, size_t stride,
+                                       perm_layout_type layout, LCGRandom& srnd)
+{
+    size_t page_lines = std::max<size_t>(g_pagesize / stride, 1);
+    size_t pages = (size + page_lines - 1) / page_lines;
+
+    std::vector<size_t> page_order(pages);
+    for (size_t p = 0; p < pages; ++p) page_order[p] = p;
+
+    if (layout == PERM_PAGE_RANDOM)
+    {
+        for (size_t n = pages; n > 1; --n)
+            std::swap(page_order[n-1], page_order[random_below(srnd, n)]);
+    }
+
+    std::vector<size_t> line_order(page_lines);
+    void** first_slot = NULL;
+    void** prev = NULL;
+
+    for (size_t p = 0; p < pages; ++p)
+    {
+        size_t first = page_order[p] * page_lines;
+        size_t lines = std::min(page_lines, size - first);
+
+        for (size_t l = 0; l < lines; ++l) line_order[l] = l;
+
+        if (layout == PERM_LINE_RANDOM)
+        {
+            for (size_t n = lines; n > 1; --n)
+                std::swap(line_order[n-1], line_order[random_below(srnd, n)]);
+        }
+
+        for (size_t l = 0; l < lines; ++l)
+        {
+            void** slot = (void**)(area + (first + line_order[l]) * stride);
+            if (prev) *prev = slot;
+            else first_slot = slot;
+            prev = slot;
+        }
+    }
+
+    // close the cycle at the first slot linked
+    *prev = first_slot;
+}
+
+// A pseudo-random permutation p of the slots 0..size-1 which depends only on
+// size and seed: a four round Feistel network over the smallest power of four
+// of at least size values, which walks values out of range around until they
+// fall into range. The cycle visits the slots in order p(0), p(1), ..., the
+// successor of each slot is computed without any memory, hence any part of the
+// cycle can be built independently and the cycle does not depend on how or by
+// how many threads it is built.
+struct PermBijection
+{
+    uint64_t    size, half_bits, half_mask, key[4];
+
+    PermBijection(uint64_t s, uint64_t seed) : size(s), half_bits(0)
+    {
+        while ((uint64_t(1) << (2 * half_bits)) < size) ++half_bits;
+        half_mask = (uint64_t(1) << half_bits) - 1;
+
+        for (int r = 0; r < 4; ++r)
+            key[r] = mix(seed + 0x9E3779B97F4A7C15LLU * (r + 1));
+    }
+
+    // splitmix64 finalizer
+    static uint64_t mix(uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9LLU;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBLLU;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t feistel(uint64_t x) const
+    {
+        uint64_t l = x >> half_bits, r = x & half_mask;
+        for (int i = 0; i < 4; ++i) {
+            uint64_t t = l ^ (mix(r ^ key[i]) & half_mask);
+            l = r, r = t;
+        }
+        return (l << half_bits) | r;
+    }
+
+    uint64_t feistel_inverse(uint64_t x) const
+    {
+        uint64_t l = x >> half_bits, r = x & half_mask;
+        for (int i = 3; i >= 0; --i) {
+            uint64_t t = r ^ (mix(l ^ key[i]) & half_mask);
+            r = l, l = t;
+        }
+        return (l << half_bits) | r;
+    }
+
+    uint64_t forward(uint64_t x) const
+    {
+        do x = feistel(x); while (x >= size);
+        return x;
+    }
+
+    uint64_t inverse(uint64_t x) const
+    {
+        do x = feistel_inverse(x); while (x >= size);
+        return x;
+    }
+
+    // successor of slot i in the cycle
+    uint64_t next(uint64_t i) const
+    {
+        uint64_t j = inverse(i) + 1;
+        return forward(j < size ? j : 0);
+    }
+};
+
+// The cycle of size slots stored as the successor index of each slot. Cycles
+// are computed once in parallel, copied into the areas of all threads, and
+// cached for later tests with the same number of slots, e.g. with further
+// thread counts.
+struct PermCycle
 {
-    void** ptrarray = (void**)memarea;
-    size_t size = bytesize / sizeof(void*);
+    uint64_t    size;
+    uint32_t*   next;
+
+    PermCycle(uint64_t s, uint32_t* n) : size(s), next(n) { }
+    ~PermCycle() { free(next); }
+};
+
+// cycles cached in order of construction and the memory they occupy
+std::vector<PermCycle*> g_perm_cache;
+uint64_t g_perm_cache_used = 0;
+
+// cycle shared by the threads of the current test, or NULL if each thread
+// computes the cycle in its own area
+const PermCycle* g_perm_cycle = NULL;
+
+// State of the parallel computation of a cycle, either into the successor
+// array of a cached cycle or directly into the area: the slots are split into
+// chunks which the helper threads compute in turn.
+struct PermCycleBuild
+{
+    uint64_t    size, chunks;
+    const PermBijection* bij;
+    uint32_t*   next;                   // successor of each slot, if cached
+
+    // area to fill with pointers, one rotated copy of the cycle per chain,
+    // the chains are interleaved slot by slot
+    char*       area;
+    size_t      stride, spread, chains;
+
+    uint64_t chunk_begin(uint64_t c) const { return c * size / chunks; }
+};
+
+typedef void (*perm_chunk_func)(PermCycleBuild& b, uint64_t c);
+
+// compute the successor of each slot of chunk c
+static void perm_build_next(PermCycleBuild& b, uint64_t c)
+{
+    for (uint64_t i = b.chunk_begin(c); i < b.chunk_begin(c+1); ++i)
+        b.next[i] = (uint32_t)b.bij->next(i);
+}
+
+// link the slots of chunk c in the area, with successors from the cached cycle
+// or computed
+static void perm_build_area(PermCycleBuild& b, uint64_t c)
+{
+    for (size_t p = 0; p < b.chains; ++p)
+    {
+        // rotate the cycle of each chain, such that the chains do not visit
+        // neighbouring slots in lockstep
+        uint64_t rot = p * b.size / b.chains;
+
+        for (uint64_t i = b.chunk_begin(c); i < b.chunk_begin(c+1); ++i)
+        {
+            uint64_t j = i + rot, k = (b.next ? b.next[i] : b.bij->next(i)) + rot;
+            if (j >= b.size) j -= b.size;
+            if (k >= b.size) k -= b.size;
+
+            *perm_slot(b.area, j * b.chains + p, b.stride, b.spread) =
+                perm_slot(b.area, k * b.chains + p, b.stride, b.spread);
+        }
+    }
+}
+
+struct PermChunkHelper
+{
+    perm_chunk_func     func;
+    PermCycleBuild*     build;
+    uint64_t            first, step;
+};
+
+static void* perm_chunk_helper(void* cookie)
+{
+    PermChunkHelper* h = (PermChunkHelper*)cookie;
+
+    for (uint64_t c = h->first; c < h->build->chunks; c += h->step)
+        h->func(*h->build, c);
+
+    return NULL;
+}
+
+// run func on all chunks of the build, spread over the given number of helper
+// threads
+static void perm_build_parallel(PermCycleBuild& b, perm_chunk_func func,
+                                uint64_t helpers)
+{
+    helpers = std::min<uint64_t>(std::max<uint64_t>(helpers, 1), b.chunks);
+
+    std::vector<PermChunkHelper> h(helpers);
+    std::vector<pthread_t> thr(helpers);
+
+    for (uint64_t t = 0; t < helpers; ++t)
+    {
+        h[t].func = func, h[t].build = &b;
+        h[t].first = t, h[t].step = helpers;
+
+        if (t != 0) pthread_create(&thr[t], NULL, perm_chunk_helper, &h[t]);
+    }
+
+    perm_chunk_helper(&h[0]);
+
+    for (uint64_t t = 1; t < helpers; ++t)
+        pthread_join(thr[t], NULL);
+}
+
+// return a cached or newly computed cycle of size slots, or NULL if it does not
+// fit into the cache budget. The budget only decides about caching, uncached
+// cycles are computed directly into the areas.
+static const PermCycle* perm_cycle_get(uint64_t size, uint64_t seed)
+{
+    for (size_t i = 0; i < g_perm_cache.size(); ++i)
+    {
+        if (g_perm_cache[i]->size == size) return g_perm_cache[i];
+    }
+
+    uint64_t need = size * sizeof(uint32_t);
+
+    if (size > 0xFFFFFFFFLLU || need > g_perm_cache_budget) return NULL;
+
+    while (g_perm_cache_used + need > g_perm_cache_budget)
+    {
+        g_perm_cache_used -= g_perm_cache.front()->size * sizeof(uint32_t);
+        delete g_perm_cache.front();
+        g_perm_cache.erase(g_perm_cache.begin());
+    }
+
+    PermBijection bij(size, seed);
+
+    PermCycleBuild b;
+    b.size = size;
+    b.chunks = std::min<uint64_t>(std::max<uint64_t>(size >> 16, 1), 1024);
+    b.bij = &bij;
+    b.next = (uint32_t*)malloc(size * sizeof(uint32_t));
+
+    if (!b.next) return NULL;
+
+    perm_build_parallel(b, perm_build_next, g_physical_cpus);
+
+    g_perm_cache.push_back(new PermCycle(size, b.next));
+    g_perm_cache_used += need;
+
+    return g_perm_cache.back();
+}
+
+// Create a one-cycle permutation of pointers in the memory area. The pointers
+// are placed every stride bytes of the layout, page layouts shift the pointer
+// by one cache line per page to spread the cycle over all cache sets. The
+// chains layout creates several cycles instead, chain c takes every chains-th
+// slot starting with slot c, hence all chains spread over the whole area.
+void make_cyclic_permutation(int thread_num, void* memarea, size_t bytesize,
+                             const TestFunction* func)
+{
+    char* area = (char*)memarea;
+    size_t stride = perm_layout_stride(func);
+    size_t size = bytesize / stride;
+
+    // number of interleaved cycles, and the cycle length of each
+    size_t chains = (func->perm_layout == PERM_CHAINS) ? func->unroll_factor : 1;
+    size_t chain_size = size / chains;
+
+    // number of different cache line shifts (64 bytes) inside a stride
+    size_t spread = (func->perm_layout == PERM_PAGE) ? stride / 64 : 1;
+
+    if (gopt_perm_lines && (func->perm_layout == PERM_WORD ||
+                            func->perm_layout == PERM_CHAINS ||
+                            func->perm_layout == PERM_PAGE_RANDOM ||
+                            func->perm_layout == PERM_LINE_RANDOM))
+        result_param(thread_num, "permline", stride);
+
+    result_param(thread_num, "seed", gopt_seed);
+
+    double ts1 = timestamp();
 
     if (thread_num == 0)
+    {
         (std::cout << "Make permutation:").flush();
+        g_perm_stride = stride;
+    }
 
     // *** Barrier ****
     pthread_barrier_wait(&g_barrier);
 
-    (std::cout << " filling").flush();
+    LCGRandom srnd(gopt_seed);
 
-    for (size_t i = 0; i < size; ++i)
+    if (func->perm_layout == PERM_PAGE_RANDOM || func->perm_layout == PERM_LINE_RANDOM)
     {
-        ptrarray[i] = &ptrarray[i]; // fill area with pointers to self-address
+        (std::cout << " linking").flush();
+
+        link_page_structured_cycle(area, size, stride, func->perm_layout, srnd);
     }
+    else
+    {
+        // thread 0 builds or fetches the cycle shared by all threads
+        if (thread_num == 0)
+        {
+            (std::cout << " building").flush();
+            g_perm_cycle = perm_cycle_get(chain_size, gopt_seed);
+        }
+
+        // *** Barrier ****
+        pthread_barrier_wait(&g_barrier);
 
-    (std::cout << " permuting").flush();
+        (std::cout << (g_perm_cycle ? " copying" : " computing")).flush();
 
-    LCGRandom srnd((size_t)ptrarray + 233349568);
+        PermBijection bij(chain_size, gopt_seed);
 
-    for (size_t n = size; n > 1; --n)
-    {
-        size_t i = srnd() % (n-1);      // permute pointers to one-cycle
-        std::swap( ptrarray[i], ptrarray[n-1] );
+        PermCycleBuild b;
+        b.size = chain_size;
+        b.chunks = std::min<uint64_t>(std::max<uint64_t>(chain_size >> 16, 1), 1024);
+        b.bij = &bij;
+        b.next = g_perm_cycle ? g_perm_cycle->next : NULL;
+        b.area = area;
+        b.stride = stride, b.spread = spread, b.chains = chains;
+
+        // the threads of the test share the cpus as helpers
+        perm_build_parallel(b, perm_build_area, g_physical_cpus / g_nthreads);
     }
 
-    if (gopt_testcycle)
+    // the page structured cycles are linked separately, always test them
+    if (gopt_testcycle || func->perm_layout == PERM_PAGE_RANDOM ||
+        func->perm_layout == PERM_LINE_RANDOM)
     {
         (std::cout << " testing").flush();
 
-        void* ptr = ptrarray[0];
-        size_t steps = 1;
-
-        while ( ptr != &ptrarray[0] && steps < size*2 )
+        for (size_t c = 0; c < chains; ++c)
         {
-            ptr = *(void**)ptr;         // walk pointer
-            ++steps;
-        }
-        (std::cout << " cycle=" << steps).flush();
+            void* ptr = *perm_slot(area, c, stride, spread);
+            size_t steps = 1;
+
+            while ( ptr != perm_slot(area, c, stride, spread) && steps < chain_size*2 )
+            {
+                ptr = *(void**)ptr;     // walk pointer
+                ++steps;
+            }
+            if (c == 0) (std::cout << " cycle=" << steps).flush();
 
-        assert(steps == size);
+            assert(steps == chain_size);
+        }
     }
     else
     {
-        (std::cout << " cycle=" << size).flush();
+        (std::cout << " cycle=" << chain_size).flush();
     }
 
+    if (chains > 1)
+        (std::cout << " chains=" << chains).flush();
+
     // *** Barrier ****
     pthread_barrier_wait(&g_barrier);
 
     if (thread_num == 0)
-        std::cout << std::endl;
+        std::cout << " time=" << timestamp() - ts1 << std::endl;
 }
 
 void* thread_master(void* cookie)
@@ -443,6 +1507,7 @@ void* thread_master(void* cookie)
     // this weirdness is because (void*) cannot be cast to int and back.
     int thread_num = *((int*)cookie);
     delete (int*)cookie;
+    t_thread_num = thread_num;
 
     // initial repeat factor is just an approximate B/s bandwidth
     uint64_t factor = 1024*1024*1024;
@@ -465,12 +1530,29 @@ void* thread_master(void* cookie)
             // divide area by thread number
             g_thrsize = *areasize / g_nthreads;
 
+            // permutation walks advance by the layout's stride per access
+            uint64_t access_offset = g_func->access_offset;
+            if (g_func->perm_layout != PERM_NONE)
+                access_offset = perm_layout_stride(g_func);
+
             // unrolled tests do up to 16 accesses without loop check, thus align
             // upward to next multiple of unroll_factor*size (e.g. 128 bytes for
             // 16-times unrolled 64-bit access)
-            uint64_t unrollsize = g_func->unroll_factor * g_func->bytes_per_access;
+            uint64_t unrollsize = g_func->unroll_factor * access_offset;
             g_thrsize = ((g_thrsize + unrollsize - 1) / unrollsize) * unrollsize;
 
+            // permutation layouts striding over more than a pointer may round
+            // up to several times the area, thus round down instead to keep
+            // the threads' parts within it, and skip if not a single block per
+            // thread remains
+            if (g_func->perm_layout != PERM_NONE && access_offset > sizeof(void*))
+            {
+                if (g_thrsize * g_nthreads > *areasize)
+                    g_thrsize -= unrollsize;
+
+                if (g_thrsize == 0) continue;
+            }
+
             // total size tested
             uint64_t testsize = g_thrsize * g_nthreads;
 
@@ -487,9 +1569,9 @@ void* thread_master(void* cookie)
             g_repeats = (factor + g_thrsize-1) / g_thrsize;         // round up
 
             // volume in bytes tested
-            uint64_t testvol = testsize * g_repeats * g_func->bytes_per_access / g_func->access_offset;
+            uint64_t testvol = testsize * g_repeats * g_func->bytes_per_access / access_offset;
             // number of accesses in test
-            uint64_t testaccess = testsize * g_repeats / g_func->access_offset;
+            uint64_t testaccess = testsize * g_repeats / access_offset;
 
             ERR("Running"
                 << " nthreads=" << g_nthreads
@@ -502,7 +1584,10 @@ void* thread_master(void* cookie)
                 << " testaccess=" << testaccess);
 
             g_done = false;
-            double runtime;
+            g_result_params.clear();
+            g_ops_name = NULL;
+            g_touched_size = 0;
+            double runtime, basetime = 0;
 
             // synchronize with worker threads and run a worker ourselves
             {
@@ -511,9 +1596,12 @@ void* thread_master(void* cookie)
 
                 assert(!g_done);
 
-                // create cyclic permutation for each thread
-                if (g_func->make_permutation)
-                    make_cyclic_permutation(thread_num, g_memarea + thread_num * g_thrsize_spaced, g_thrsize);
+                // create cyclic permutation or prepare area for each thread
+                if (g_func->perm_layout != PERM_NONE)
+                    make_cyclic_permutation(thread_num, g_memarea + thread_num * g_thrsize_spaced, g_thrsize,
+                                            g_func);
+                else if (g_func->prepare)
+                    g_func->prepare(thread_num, g_memarea + thread_num * g_thrsize_spaced, g_thrsize);
 
                 // *** Barrier ****
                 pthread_barrier_wait(&g_barrier);
@@ -526,6 +1614,18 @@ void* thread_master(void* cookie)
                 double ts2 = timestamp();
 
                 runtime = ts2 - ts1;
+
+                // time the same stores without fences
+                if (g_func->fence_baseline)
+                {
+                    g_func->fence_baseline(g_memarea + thread_num * g_thrsize_spaced, g_thrsize, g_repeats);
+
+                    // *** Barrier ****
+                    pthread_barrier_wait(&g_barrier);
+                    double ts3 = timestamp();
+
+                    basetime = ts3 - ts2;
+                }
             }
 
             if ( runtime < g_min_time )
@@ -545,6 +1645,15 @@ void* thread_master(void* cookie)
                 factor = g_thrsize * g_repeats * g_avg_time / runtime;
                 ERR("run time = " << runtime << " -> next test with repeat factor=" << factor);
 
+                // count only the accessed part of the area, if the test
+                // reported one
+                if (g_touched_size)
+                {
+                    uint64_t touched = g_touched_size * g_nthreads;
+                    testvol = touched * g_repeats * g_func->bytes_per_access / access_offset;
+                    testaccess = touched * g_repeats / access_offset;
+                }
+
                 std::ostringstream result;
                 result << "RESULT\t";
 
@@ -568,6 +1677,29 @@ void* thread_master(void* cookie)
                        << "bandwidth=" << testvol / runtime << '\t'
                        << "rate=" << runtime / testaccess;
 
+                result << g_result_params;
+
+                if (g_ops_name)
+                {
+                    uint64_t testops = g_ops_per_repeat * g_repeats * g_nthreads;
+                    result << '\t' << "opname=" << g_ops_name
+                           << '\t' << "ops=" << testops
+                           << '\t' << "opsrate=" << testops / runtime;
+                }
+
+                if (g_func->fence_interval)
+                {
+                    // cost per fence beyond the same stores without fences
+                    uint64_t testfences = testaccess / g_func->fence_interval;
+                    result << '\t' << "fences=" << testfences
+                           << '\t' << "basetime=" << basetime;
+                    if (testfences)
+                        result << '\t' << "fencetime=" << (runtime - basetime) / testfences;
+                }
+
+                if (gopt_hugepages >= 0)
+                    result << '\t' << "hugepages=" << gopt_hugepages;
+
                 std::cout << result.str() << std::endl;
 
                 std::ofstream resultfile(gopt_output_file, std::ios::app);
@@ -581,6 +1713,8 @@ void* thread_master(void* cookie)
     // *** Barrier ****
     pthread_barrier_wait(&g_barrier);
 
+    thread_auxarea_free();
+
     return NULL;
 }
 
@@ -589,6 +1723,7 @@ void* thread_worker(void* cookie)
     // this weirdness is because (void*) cannot be cast to int and back.
     int thread_num = *((int*)cookie);
     delete (int*)cookie;
+    t_thread_num = thread_num;
 
     while (1)
     {
@@ -597,9 +1732,12 @@ void* thread_worker(void* cookie)
 
         if (g_done) break;
 
-        // create cyclic permutation for each thread
-        if (g_func->make_permutation)
-            make_cyclic_permutation(thread_num, g_memarea + thread_num * g_thrsize_spaced, g_thrsize);
+        // create cyclic permutation or prepare area for each thread
+        if (g_func->perm_layout != PERM_NONE)
+            make_cyclic_permutation(thread_num, g_memarea + thread_num * g_thrsize_spaced, g_thrsize,
+                                    g_func);
+        else if (g_func->prepare)
+            g_func->prepare(thread_num, g_memarea + thread_num * g_thrsize_spaced, g_thrsize);
 
         // *** Barrier ****
         pthread_barrier_wait(&g_barrier);
@@ -608,8 +1746,18 @@ void* thread_worker(void* cookie)
 
         // *** Barrier ****
         pthread_barrier_wait(&g_barrier);
+
+        if (g_func->fence_baseline)
+        {
+            g_func->fence_baseline(g_memarea + thread_num * g_thrsize_spaced, g_thrsize, g_repeats);
+
+            // *** Barrier ****
+            pthread_barrier_wait(&g_barrier);
+        }
     }
 
+    thread_auxarea_free();
+
     return NULL;
 }
 
@@ -675,13 +1823,23 @@ void print_usage(const char* prog)
     ERR("Usage: " << prog << " [options]" << std::endl
         << "Options:" << std::endl
         << "  -f <match>     Run only benchmarks containing this substring, can be used multile times. Try \"list\"." << std::endl
+        << "  -F <fraction>  Selectivity of the predicate of FilterCompact benchmarks, default 0.5." << std::endl
+        << "  -H <0|1>       Back the memory area with small pages (0) or transparent huge pages (1)." << std::endl
+        << "  -l <size>      Permute Perm benchmarks at cache line granularity: one pointer per <size> byte line, 0 = detect." << std::endl
+        << "  -L <factor>    Load factor of the hash tables of HashProbe benchmarks, default 0.7." << std::endl
         << "  -M <size>      Limit the maximum amount of memory allocated at startup [byte]." << std::endl
+        << "  -N <count>     Nonzeros per row of the sparse matrices of SpMV benchmarks, default 16." << std::endl
         << "  -o <file>      Write the results to <file> instead of stats.txt." << std::endl
         << "  -p <nthrs>     Run benchmarks with at least this thread count." << std::endl
         << "  -P <nthrs>     Run benchmarks with at most this thread count (overrides detected processor count)." << std::endl
         << "  -Q             Run benchmarks with quadratically increasing thread count." << std::endl
+        << "  -R, --seed <n> Seed of random permutations and pointer streams, default 233349568." << std::endl
         << "  -s <size>      Limit the _minimum_ test array size [byte]. Set to 0 for no limit." << std::endl
         << "  -S <size>      Limit the _maximum_ test array size [byte]. Set to 0 for no limit." << std::endl
+        << "  -T <elements>  Edge length of the tiles of blocked Transpose benchmarks, multiple of 8, default 32." << std::endl
+        << "  -z <exponent>  Exponent of the Zipf distribution of Zipf benchmarks, default 0.99." << std::endl
+        << "  -C <l,m,d>     Mean literal run, match length (>= 4) and maximum match distance (0 = area, at most 4 GiB - 1) of LZ benchmarks, default \"4,16,0\"." << std::endl
+        << "  -D <spec>      Reuse distance histogram of Reuse benchmarks, default \"16K:0.4,256K:0.3,8M:0.2,inf:0.1\"." << std::endl
         );
 }
 
@@ -691,7 +1849,12 @@ int main(int argc, char* argv[])
 
     int opt;
 
-    while ( (opt = getopt(argc, argv, "hf:M:o:p:P:Qs:S:")) != -1 )
+    static const struct option longopts[] = {
+        { "seed", required_argument, NULL, 'R' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    while ( (opt = getopt_long(argc, argv, "hC:D:f:F:H:l:L:M:N:o:p:P:QR:s:S:T:z:", longopts, NULL)) != -1 )
     {
         switch (opt) {
         default:
@@ -699,6 +1862,28 @@ int main(int argc, char* argv[])
             print_usage(argv[0]);
             return EXIT_FAILURE;
 
+        case 'C':
+            if (!parse_lz_spec(optarg)) {
+                ERR("Invalid parameter for -C <literals,match,maxdist>.");
+                exit(EXIT_FAILURE);
+            }
+            else {
+                gopt_lz_spec = optarg;
+                ERR("Running LZ benchmarks with literal runs, match lengths and maximum distance " << gopt_lz_spec << ".");
+            }
+            break;
+
+        case 'D':
+            if (!parse_reuse_spec(optarg)) {
+                ERR("Invalid parameter for -D <reuse distance histogram>.");
+                exit(EXIT_FAILURE);
+            }
+            else {
+                gopt_reuse_spec = optarg;
+                ERR("Running Reuse benchmarks with reuse distance histogram " << gopt_reuse_spec << ".");
+            }
+            break;
+
         case 'f':
             if (strcmp(optarg,"list") == 0)
             {
@@ -721,6 +1906,49 @@ int main(int argc, char* argv[])
             ERR("Running only functions containing '" << optarg << "'");
             break;
 
+        case 'H':
+            if (!parse_int(optarg, gopt_hugepages) || gopt_hugepages < 0 || gopt_hugepages > 1) {
+                ERR("Invalid parameter for -H <huge pages>.");
+                exit(EXIT_FAILURE);
+            }
+            else if (gopt_hugepages) {
+                ERR("Backing memory area with transparent huge pages.");
+            }
+            else {
+                ERR("Backing memory area with small pages only.");
+            }
+            break;
+
+        case 'F':
+            if (!parse_double(optarg, gopt_filter_selectivity) || gopt_filter_selectivity < 0 || gopt_filter_selectivity > 1) {
+                ERR("Invalid parameter for -F <selectivity>.");
+                exit(EXIT_FAILURE);
+            }
+            else {
+                ERR("Running FilterCompact benchmarks with selectivity " << gopt_filter_selectivity << ".");
+            }
+            break;
+
+        case 'L':
+            if (!parse_double(optarg, gopt_hash_load) || gopt_hash_load <= 0 || gopt_hash_load >= 1) {
+                ERR("Invalid parameter for -L <hash table load factor>.");
+                exit(EXIT_FAILURE);
+            }
+            else {
+                ERR("Running HashProbe benchmarks with load factor " << gopt_hash_load << ".");
+            }
+            break;
+
+        case 'l':
+            if (!parse_uint64t(optarg, gopt_perm_linesize) ||
+                (gopt_perm_linesize & (gopt_perm_linesize - 1)) != 0 ||
+                (gopt_perm_linesize != 0 && gopt_perm_linesize < sizeof(void*))) {
+                ERR("Invalid parameter for -l <line size>.");
+                exit(EXIT_FAILURE);
+            }
+            gopt_perm_lines = true;
+            break;
+
         case 'M':
             if (!parse_uint64t(optarg, gopt_memlimit)) {
                 ERR("Invalid parameter for -M <memory limit>.");
@@ -734,6 +1962,16 @@ int main(int argc, char* argv[])
             }
             break;
 
+        case 'N':
+            if (!parse_uint64t(optarg, gopt_spmv_nnz) || gopt_spmv_nnz == 0) {
+                ERR("Invalid parameter for -N <nonzeros per row>.");
+                exit(EXIT_FAILURE);
+            }
+            else {
+                ERR("Running SpMV benchmarks with " << gopt_spmv_nnz << " nonzeros per row.");
+            }
+            break;
+
         case 'o':
             gopt_output_file = optarg;
             ERR("Writing results to " << gopt_output_file << ".");
@@ -764,6 +2002,16 @@ int main(int argc, char* argv[])
             }
             break;
 
+        case 'R':
+            if (!parse_uint64t(optarg, gopt_seed)) {
+                ERR("Invalid parameter for -R/--seed <seed>.");
+                exit(EXIT_FAILURE);
+            }
+            else {
+                ERR("Seeding random permutations and pointer streams with " << gopt_seed << ".");
+            }
+            break;
+
         case 's':
             if (!parse_uint64t(optarg, gopt_sizelimit_min)) {
                 ERR("Invalid parameter for -s <minimum size limit>.");
@@ -789,6 +2037,27 @@ int main(int argc, char* argv[])
                 ERR("Running benchmarks with array size up to " << gopt_sizelimit_max << ".");
             }
             break;
+
+        case 'T':
+            if (!parse_uint64t(optarg, gopt_transpose_tile) ||
+                gopt_transpose_tile == 0 || gopt_transpose_tile % 8 != 0) {
+                ERR("Invalid parameter for -T <tile size>.");
+                exit(EXIT_FAILURE);
+            }
+            else {
+                ERR("Running blocked Transpose benchmarks with " << gopt_transpose_tile << "x" << gopt_transpose_tile << " tiles.");
+            }
+            break;
+
+        case 'z':
+            if (!parse_double(optarg, gopt_zipf_exponent) || gopt_zipf_exponent < 0) {
+                ERR("Invalid parameter for -z <Zipf exponent>.");
+                exit(EXIT_FAILURE);
+            }
+            else {
+                ERR("Running Zipf benchmarks with exponent " << gopt_zipf_exponent << ".");
+            }
+            break;
         }
     }
 
@@ -799,15 +2068,29 @@ int main(int argc, char* argv[])
     GetComputerName(g_hostname, &hostnameSize);
 #endif
 
+    if (g_reuse_histogram.empty())
+        parse_reuse_spec(gopt_reuse_spec);
+
     // *** run CPUID
     cpuid_detect();
 
+    g_layer_cachesize = detect_l2_cachesize();
+
+    if (gopt_perm_lines)
+    {
+        if (gopt_perm_linesize == 0)
+            gopt_perm_linesize = detect_cache_linesize();
+
+        ERR("Permuting at cache line granularity of " << gopt_perm_linesize << " bytes.");
+    }
+
     // *** allocate memory for tests
 
 #if !ON_WINDOWS
 
     size_t physical_mem = sysconf(_SC_PHYS_PAGES) * (size_t)sysconf(_SC_PAGESIZE);
     g_physical_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    g_pagesize = sysconf(_SC_PAGESIZE);
 
 #else
 
@@ -821,6 +2104,7 @@ int main(int argc, char* argv[])
     GetSystemInfo( &sysinfo );
 
     g_physical_cpus = sysinfo.dwNumberOfProcessors;
+    g_pagesize = sysinfo.dwPageSize;
 
 #endif
 
@@ -838,11 +2122,18 @@ int main(int argc, char* argv[])
 
     ERR("Allocating " << g_memsize / 1024/1024 << " MiB for testing.");
 
+    // leave half of the remaining memory to cached permutation cycles
+    if (physical_mem > g_memsize)
+        g_perm_cache_budget = (physical_mem - g_memsize) / 2;
+
     // allocate memory area
 
 #if HAVE_POSIX_MEMALIGN
 
-    if (posix_memalign((void**)&g_memarea, 32, g_memsize) != 0) {
+    // align to huge pages (2 MiB) if their use is to be set via madvise()
+    size_t alignment = (gopt_hugepages >= 0) ? 2*1024*1024 : 32;
+
+    if (posix_memalign((void**)&g_memarea, alignment, g_memsize) != 0) {
         ERR("Error allocating memory.");
         return -1;
     }
@@ -853,6 +2144,22 @@ int main(int argc, char* argv[])
 
 #endif
 
+#if !ON_WINDOWS && defined(MADV_HUGEPAGE)
+    if (gopt_hugepages >= 0)
+    {
+        // round down to whole pages, as madvise() only works on full pages
+        size_t advsize = g_memsize / g_pagesize * g_pagesize;
+
+        if (madvise(g_memarea, advsize,
+                    gopt_hugepages ? MADV_HUGEPAGE : MADV_NOHUGEPAGE) != 0) {
+            ERR("Error setting huge page policy via madvise(): " << strerror(errno));
+        }
+    }
+#else
+    if (gopt_hugepages >= 0)
+        ERR("Setting huge page policy is not supported on this platform, ignoring -H.");
+#endif
+
     // fill memory with junk, but this allocates physical memory
     memset(g_memarea, 1, g_memsize);
 
@@ -871,13 +2178,26 @@ int main(int argc, char* argv[])
             continue;
         }
 
+        if (tf->exec_area && !protect_memarea(true))
+        {
+            ERR("Skipping " << tf->name << " test "
+                << "due to non-executable memory area.");
+            continue;
+        }
+
         testfunc(tf);
+
+        if (tf->exec_area)
+            protect_memarea(false);
     }
 
     // cleanup
 
     free(g_memarea);
 
+    for (size_t i = 0; i < g_perm_cache.size(); ++i)
+        delete g_perm_cache[i];
+
     for (size_t i = 0; i < g_testlist.size(); ++i)
         delete g_testlist[i];
 
@@ -58,6 +58,29 @@ static const char* funclist[] =
     "ScanRead256PtrSimpleLoop",
     "ScanRead256PtrUnrollLoop",
 
+    "ScanWrite128PairPtrUnrollLoop",
+    "ScanWriteNT128PairPtrUnrollLoop",
+    "ScanRead128PairPtrUnrollLoop",
+    "ScanReadNT128PairPtrUnrollLoop",
+    "ScanWrite256PairPtrUnrollLoop",
+    "ScanWriteNT256PairPtrUnrollLoop",
+    "ScanRead256PairPtrUnrollLoop",
+    "ScanReadNT256PairPtrUnrollLoop",
+    "ScanWrite512PairPtrUnrollLoop",
+    "ScanWriteNT512PairPtrUnrollLoop",
+    "ScanRead512PairPtrUnrollLoop",
+    "ScanReadNT512PairPtrUnrollLoop",
+    "ScanRead256PairPtrPldL1Keep256BLoop",
+    "ScanRead256PairPtrPldL1Keep1KLoop",
+    "ScanRead256PairPtrPldL1Keep4KLoop",
+    "ScanRead256PairPtrPldL2Strm256BLoop",
+    "ScanRead256PairPtrPldL2Strm1KLoop",
+    "ScanRead256PairPtrPldL2Strm4KLoop",
+
+    "ScanZeroDcZvaLoop",
+    "ScanZeroStpLoop",
+    "ScanZeroStnpLoop",
+
     "ScanWrite128PtrSimpleLoop",
     "ScanWrite128PtrUnrollLoop",
     "ScanRead128PtrSimpleLoop",
@@ -93,13 +116,171 @@ static const char* funclist[] =
     "ScanRead16PtrSimpleLoop",
     "ScanRead16PtrUnrollLoop",
 
+    "ScanWrite64PtrSfence1Loop",
+    "ScanWrite64PtrSfence4Loop",
+    "ScanWrite64PtrSfence16Loop",
+    "ScanWrite64PtrSfence64Loop",
+    "ScanWrite64PtrMfence1Loop",
+    "ScanWrite64PtrMfence4Loop",
+    "ScanWrite64PtrMfence16Loop",
+    "ScanWrite64PtrMfence64Loop",
+    "ScanWrite64PtrLfence1Loop",
+    "ScanWrite64PtrLfence4Loop",
+    "ScanWrite64PtrLfence16Loop",
+    "ScanWrite64PtrLfence64Loop",
+    "ScanWriteNT64PtrSfence1Loop",
+    "ScanWriteNT64PtrSfence4Loop",
+    "ScanWriteNT64PtrSfence16Loop",
+    "ScanWriteNT64PtrSfence64Loop",
+    "ScanWriteNT64PtrMfence1Loop",
+    "ScanWriteNT64PtrMfence4Loop",
+    "ScanWriteNT64PtrMfence16Loop",
+    "ScanWriteNT64PtrMfence64Loop",
+    "ScanWriteNT64PtrLfence1Loop",
+    "ScanWriteNT64PtrLfence4Loop",
+    "ScanWriteNT64PtrLfence16Loop",
+    "ScanWriteNT64PtrLfence64Loop",
+
+    "ScanWrite128PtrDmbIshst1Loop",
+    "ScanWrite128PtrDmbIshst4Loop",
+    "ScanWrite128PtrDmbIshst16Loop",
+    "ScanWrite128PtrDmbIshst64Loop",
+    "ScanWrite128PtrDmbIsh1Loop",
+    "ScanWrite128PtrDmbIsh4Loop",
+    "ScanWrite128PtrDmbIsh16Loop",
+    "ScanWrite128PtrDmbIsh64Loop",
+    "ScanWrite128PtrDsbIsh1Loop",
+    "ScanWrite128PtrDsbIsh4Loop",
+    "ScanWrite128PtrDsbIsh16Loop",
+    "ScanWrite128PtrDsbIsh64Loop",
+    "ScanWriteNT128PtrDmbIshst1Loop",
+    "ScanWriteNT128PtrDmbIshst4Loop",
+    "ScanWriteNT128PtrDmbIshst16Loop",
+    "ScanWriteNT128PtrDmbIshst64Loop",
+    "ScanWriteNT128PtrDmbIsh1Loop",
+    "ScanWriteNT128PtrDmbIsh4Loop",
+    "ScanWriteNT128PtrDmbIsh16Loop",
+    "ScanWriteNT128PtrDmbIsh64Loop",
+    "ScanWriteNT128PtrDsbIsh1Loop",
+    "ScanWriteNT128PtrDsbIsh4Loop",
+    "ScanWriteNT128PtrDsbIsh16Loop",
+    "ScanWriteNT128PtrDsbIsh64Loop",
+
+    "ScanExec64NopLoop",
+    "ScanExec32NopLoop",
+
     "PermRead64SimpleLoop",
     "PermRead64UnrollLoop",
     "cPermRead64SimpleLoop",
+    "PermPageRead64SimpleLoop",
+    "cPermPageRead64SimpleLoop",
+    "PermPageRandLineSeqRead64SimpleLoop",
+    "cPermPageRandLineSeqRead64SimpleLoop",
+    "PermPageSeqLineRandRead64SimpleLoop",
+    "cPermPageSeqLineRandRead64SimpleLoop",
+    "PermBlock64BRead128Loop",
+    "PermBlock256BRead128Loop",
+    "PermBlock1KRead128Loop",
+    "PermBlock4KRead128Loop",
+    "PermBlock16KRead128Loop",
+    "PermBlock64KRead128Loop",
+    "PermBlock256KRead128Loop",
+    "PermBlock1MRead128Loop",
+    "List32BNodeRead0x64Loop",
+    "List32BNodeRead1x64Loop",
+    "List32BNodeRead2x64Loop",
+    "List32BNodeRead3x64Loop",
+    "List64BNodeRead0x64Loop",
+    "List64BNodeRead1x64Loop",
+    "List64BNodeRead2x64Loop",
+    "List64BNodeRead7x64Loop",
+    "List128BNodeRead0x64Loop",
+    "List128BNodeRead1x64Loop",
+    "List128BNodeRead4x64Loop",
+    "List128BNodeRead15x64Loop",
+    "List256BNodeRead0x64Loop",
+    "List256BNodeRead1x64Loop",
+    "List256BNodeRead8x64Loop",
+    "List256BNodeRead31x64Loop",
+    "List512BNodeRead0x64Loop",
+    "List512BNodeRead1x64Loop",
+    "List512BNodeRead16x64Loop",
+    "List512BNodeRead63x64Loop",
+    "PermRead64Chains2Loop",
+    "PermRead64Chains4Loop",
+    "PermRead64Chains8Loop",
+    "PermRead64Chains16Loop",
+    "PermRead64Chains32Loop",
+
+    "ZipfRead64PtrSimpleLoop",
+    "ZipfRead64PtrDependLoop",
+    "ReuseRead64PtrSimpleLoop",
+    "ReuseRead64PtrDependLoop",
+
+    "SearchBinary64Loop",
+    "SearchEytzinger64PrefetchLoop",
+    "SearchBTree64Loop",
+    "HashProbe64Hit90Loop",
+    "HashProbe64Hit10Loop",
+    "RadixScatter64Fanout2Loop",
+    "RadixScatter64Fanout4Loop",
+    "RadixScatter64Fanout16Loop",
+    "RadixScatter64Fanout64Loop",
+    "RadixScatter64Fanout256Loop",
+    "RadixScatter64Fanout1024Loop",
+    "RadixScatter64Fanout4096Loop",
+    "RadixScatterWC64Fanout2Loop",
+    "RadixScatterWC64Fanout4Loop",
+    "RadixScatterWC64Fanout16Loop",
+    "RadixScatterWC64Fanout64Loop",
+    "RadixScatterWC64Fanout256Loop",
+    "RadixScatterWC64Fanout1024Loop",
+    "RadixScatterWC64Fanout4096Loop",
+    "FilterCompact32Loop",
+    "FilterCompact128Loop",
+    "FilterCompact256Loop",
+    "FilterCompact512Loop",
+    "PrefixSum32Loop",
+    "PrefixSum64Loop",
+    "PrefixSum32Vec128Loop",
+    "PrefixSum64Vec128Loop",
+    "PrefixSum32TwoPassLoop",
+    "PrefixSum64TwoPassLoop",
+    "PrefixSum32LookBackLoop",
+    "PrefixSum64LookBackLoop",
+    "TransposeNaive64Loop",
+    "TransposeBlocked64Loop",
+    "TransposeBlockedNT64Loop",
+    "Stencil1D64Loop",
+    "Stencil2D64Loop",
+    "Stencil3D64Loop",
+    "SpMVBanded64Loop",
+    "SpMVRandom64Loop",
+    "SpMVPowerLaw64Loop",
+    "LibcMemsetLoop",
+    "LibcMemcpyLoop",
+    "LibcMemmoveLoop",
+    "LibcMemmoveOverlapLoop",
+    "StdCopy64Loop",
+    "LZDecodeLoop",
+    "Crc32c64Loop",
+    "Crc32c64Way2Loop",
+    "Crc32c64Way3Loop",
 
     "PermRead32SimpleLoop",
     "PermRead32UnrollLoop",
     "cPermRead32SimpleLoop",
+    "PermPageRead32SimpleLoop",
+    "cPermPageRead32SimpleLoop",
+    "PermPageRandLineSeqRead32SimpleLoop",
+    "cPermPageRandLineSeqRead32SimpleLoop",
+    "PermPageSeqLineRandRead32SimpleLoop",
+    "cPermPageSeqLineRandRead32SimpleLoop",
+    "PermRead32Chains2Loop",
+    "PermRead32Chains4Loop",
+    "PermRead32Chains8Loop",
+    "PermRead32Chains16Loop",
+    "PermRead32Chains32Loop",
 
     NULL
 };
@@ -126,12 +307,32 @@ struct Result
     double time;
     double bandwidth;
     double rate;
+    size_t fences;
+    double basetime;
+    double fencetime;
+    double zipf;
+    std::string reuse;
+    size_t permline;
+    size_t seed;
+    double load;
+    double selectivity;
+    size_t dim;
+    size_t tile;
+    size_t layercache;
+    size_t nnz;
+    std::string lz;
+    size_t zvablock;
+    std::string opname;
+    size_t ops;
+    double opsrate;
+    size_t hugepages;
     size_t funcname_id;  // index of funcname in funclist (for nicer order)
 
     Result()
         : nthreads(0), areasize(0), threadsize(0), testsize(0), repeats(0),
           testvol(0), testaccess(0),
-          time(0), bandwidth(0), rate(0)
+          time(0), bandwidth(0), rate(0), fences(0), basetime(0), fencetime(0), zipf(0), permline(0),
+          seed(0), load(0), selectivity(0), dim(0), tile(0), layercache(0), nnz(0), zvablock(0), ops(0), opsrate(0), hugepages(0)
     {
     }
 
@@ -246,6 +447,66 @@ bool Result::process_line_keyvalue(const std::string& key, const std::string& va
     else if (key == "rate") {
         return parse_double(value, rate);
     }
+    else if (key == "fences") {
+        return parse_sizet(value, fences);
+    }
+    else if (key == "basetime") {
+        return parse_double(value, basetime);
+    }
+    else if (key == "fencetime") {
+        return parse_double(value, fencetime);
+    }
+    else if (key == "zipf") {
+        return parse_double(value, zipf);
+    }
+    else if (key == "reuse") {
+        reuse = value;
+        return true;
+    }
+    else if (key == "permline") {
+        return parse_sizet(value, permline);
+    }
+    else if (key == "seed") {
+        return parse_sizet(value, seed);
+    }
+    else if (key == "load") {
+        return parse_double(value, load);
+    }
+    else if (key == "selectivity") {
+        return parse_double(value, selectivity);
+    }
+    else if (key == "dim") {
+        return parse_sizet(value, dim);
+    }
+    else if (key == "tile") {
+        return parse_sizet(value, tile);
+    }
+    else if (key == "layercache") {
+        return parse_sizet(value, layercache);
+    }
+    else if (key == "nnz") {
+        return parse_sizet(value, nnz);
+    }
+    else if (key == "lz") {
+        lz = value;
+        return true;
+    }
+    else if (key == "zvablock") {
+        return parse_sizet(value, zvablock);
+    }
+    else if (key == "opname") {
+        opname = value;
+        return true;
+    }
+    else if (key == "ops") {
+        return parse_sizet(value, ops);
+    }
+    else if (key == "opsrate") {
+        return parse_double(value, opsrate);
+    }
+    else if (key == "hugepages") {
+        return parse_sizet(value, hugepages);
+    }
     else {
         return false;
     }